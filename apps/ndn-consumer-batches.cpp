@@ -28,6 +28,7 @@
 #include "ns3/double.h"
 
 #include "utils/batches.hpp"
+#include "utils/ndn-event-accounting.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerBatches");
 
@@ -91,7 +92,8 @@ ConsumerBatches::ScheduleNextPacket()
       delay = m_rtt->RetransmitTimeout();
 
     m_initial = false;
-    m_sendEvent = Simulator::Schedule(delay, &Consumer::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND, delay, &Consumer::SendPacket,
+                                            this);
   }
 }
 
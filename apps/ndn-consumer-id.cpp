@@ -18,6 +18,8 @@
 #include "ns3/integer.h"
 #include "ns3/double.h"
 
+#include "utils/ndn-event-accounting.hpp"
+
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerCbrId");
 
 namespace ns3 {
@@ -57,13 +59,15 @@ void
 ConsumerCbrId::ScheduleNextPacket()
 {
   if (m_firstTime) {
-    m_sendEvent = Simulator::Schedule(Seconds(0.0), &Consumer::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND, Seconds(0.0),
+                                            &Consumer::SendPacket, this);
     m_firstTime = false;
   }
   else if (!m_sendEvent.IsRunning())
-    m_sendEvent = Simulator::Schedule((m_random == 0) ? Seconds(1.0 / m_frequency)
-                                                      : Seconds(m_random->GetValue()),
-                                      &ConsumerCbrId::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND,
+                                            (m_random == 0) ? Seconds(1.0 / m_frequency)
+                                                            : Seconds(m_random->GetValue()),
+                                            &ConsumerCbrId::SendPacket, this);
 }
 
 void
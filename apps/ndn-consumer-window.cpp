@@ -26,6 +26,9 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+
+#include "utils/ndn-event-accounting.hpp"
+
 #include <limits>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerWindow");
@@ -162,9 +165,10 @@ ConsumerWindow::ScheduleNextPacket()
       "Next event in " << (std::min<double>(0.5, m_rtt->RetransmitTimeout().ToDouble(Time::S)))
                        << " sec");
     m_sendEvent =
-      Simulator::Schedule(Seconds(
-                            std::min<double>(0.5, m_rtt->RetransmitTimeout().ToDouble(Time::S))),
-                          &Consumer::SendPacket, this);
+      EventAccounting::Schedule(EventAccounting::APP_SEND,
+                                Seconds(std::min<double>(0.5, m_rtt->RetransmitTimeout()
+                                                                .ToDouble(Time::S))),
+                                &Consumer::SendPacket, this);
   }
   else if (m_inFlight >= m_window) {
     // simply do nothing
@@ -174,7 +178,8 @@ ConsumerWindow::ScheduleNextPacket()
       Simulator::Remove(m_sendEvent);
     }
 
-    m_sendEvent = Simulator::ScheduleNow(&Consumer::SendPacket, this);
+    m_sendEvent = EventAccounting::ScheduleNow(EventAccounting::APP_SEND, &Consumer::SendPacket,
+                                               this);
   }
 }
 
@@ -21,6 +21,8 @@
 
 #include "ndn-consumer-zipf-mandelbrot.hpp"
 
+#include "utils/ndn-event-accounting.hpp"
+
 #include <math.h>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
@@ -225,13 +227,15 @@ ConsumerZipfMandelbrot::ScheduleNextPacket()
 {
 
   if (m_firstTime) {
-    m_sendEvent = Simulator::Schedule(Seconds(0.0), &ConsumerZipfMandelbrot::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND, Seconds(0.0),
+                                            &ConsumerZipfMandelbrot::SendPacket, this);
     m_firstTime = false;
   }
   else if (!m_sendEvent.IsRunning())
-    m_sendEvent = Simulator::Schedule((m_random == 0) ? Seconds(1.0 / m_frequency)
-                                                      : Seconds(m_random->GetValue()),
-                                      &ConsumerZipfMandelbrot::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND,
+                                            (m_random == 0) ? Seconds(1.0 / m_frequency)
+                                                            : Seconds(m_random->GetValue()),
+                                            &ConsumerZipfMandelbrot::SendPacket, this);
 }
 
 } /* namespace ndn */
@@ -31,6 +31,7 @@
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/ndn-event-accounting.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
 
@@ -99,7 +100,8 @@ Consumer::SetRetxTimer(Time retxTimer)
   }
 
   // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  m_retxEvent = EventAccounting::Schedule(EventAccounting::RETX_TIMER, m_retxTimer,
+                                           &Consumer::CheckRetxTimeout, this);
 }
 
 Time
@@ -129,7 +131,8 @@ Consumer::CheckRetxTimeout()
       break; // nothing else to do. All later packets need not be retransmitted
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  m_retxEvent = EventAccounting::Schedule(EventAccounting::RETX_TIMER, m_retxTimer,
+                                           &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
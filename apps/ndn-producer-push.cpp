@@ -14,6 +14,8 @@
 #include "ns3/simulator.h"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-virtual-payload.hpp"
+#include "utils/ndn-event-accounting.hpp"
 #include <memory>
 
 #include "ns3/double.h"
@@ -97,7 +99,12 @@ ProducerPush::SendPacket()
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
+  if (m_isPayloadVirtual) {
+    VirtualPayload::Set(*data, m_virtualPayloadSize);
+  }
+  else {
+    data->setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
+  }
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
@@ -165,13 +172,15 @@ ProducerPush::ScheduleNextPacket()
 {
 
   if (m_firstTime) {
-    m_sendEvent = Simulator::Schedule(Seconds(0.0), &ProducerPush::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND, Seconds(0.0),
+                                            &ProducerPush::SendPacket, this);
     m_firstTime = false;
   }
   else if (!m_sendEvent.IsRunning())
-    m_sendEvent = Simulator::Schedule((m_random == 0) ? Seconds(1.0 / m_frequency)
-                                                      : Seconds(m_random->GetValue()),
-                                      &ProducerPush::SendPacket, this);
+    m_sendEvent = EventAccounting::Schedule(EventAccounting::APP_SEND,
+                                            (m_random == 0) ? Seconds(1.0 / m_frequency)
+                                                            : Seconds(m_random->GetValue()),
+                                            &ProducerPush::SendPacket, this);
 }
 
 void
@@ -21,11 +21,13 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-virtual-payload.hpp"
 
 #include <memory>
 
@@ -53,6 +55,11 @@ Producer::GetTypeId(void)
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
                     MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("VirtualPayload",
+                    "If true, Data carry only the size of the payload, but are sent over links "
+                    "as if they had PayloadSize bytes of content",
+                    BooleanValue(false), MakeBooleanAccessor(&Producer::m_isPayloadVirtual),
+                    MakeBooleanChecker())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
                     TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
                     MakeTimeChecker())
@@ -108,7 +115,12 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  if (m_isPayloadVirtual) {
+    VirtualPayload::Set(*data, m_virtualPayloadSize);
+  }
+  else {
+    data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  }
 
   Signature signature;
   SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
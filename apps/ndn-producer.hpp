@@ -64,6 +64,7 @@ protected:  // For derivative, Jiangtao Luo. 11 Feb 2020
   Name m_prefix;
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool m_isPayloadVirtual;
   Time m_freshness;
 
   uint32_t m_signature;
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-convert.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace ns3 {
+
+/**
+ * This program converts binary traces, written by trace helpers installed with
+ * TraceFormat::BINARY, into the usual tab-separated text layout:
+ *
+ *     ./waf --run="ndn-trace-convert --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If output is not specified (or is "-"), the text trace is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Text trace file (- for standard output)", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "Cannot open " << input << " for reading" << std::endl;
+    return 1;
+  }
+
+  if (output == "-") {
+    ndn::BinaryTraceReader::ConvertToText(is, std::cout);
+    return 0;
+  }
+
+  std::ofstream os(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os.is_open()) {
+    std::cerr << "Cannot open " << output << " for writing" << std::endl;
+    return 1;
+  }
+
+  ndn::BinaryTraceReader::ConvertToText(is, os);
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
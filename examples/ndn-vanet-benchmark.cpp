@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-vanet-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wave-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ndn.VanetBenchmark");
+
+/**
+ * This scenario is a scaling benchmark of a VANET deployment: vehicles on a multi-lane highway
+ * and road-side units (RSUs) along it, all equipped with WAVE devices on one shared channel.
+ * RSUs are also connected with each other by a point-to-point backbone.
+ *
+ *       RSU ======== RSU ======== RSU ======== RSU      (backbone, 1 Gbps, 1 ms)
+ *
+ *     ->  v   v    v     v   v    v   v     v   v  ->    (vehicles, WAVE)
+ *     <-    v    v   v     v    v      v  v    v   <-
+ *
+ * - every RSU runs a Producer for /content, routes towards the nearest RSU are calculated by
+ *   GlobalRoutingHelper over the backbone and the WAVE channel;
+ * - a fraction of vehicles (--consumers) requests /content following Zipf-Mandelbrot
+ *   distribution;
+ * - a fraction of vehicles (--emergency) pushes emergency Data under /emergency/<node> using
+ *   ProducerPush;
+ * - all nodes cache Data in NFD's content store.
+ *
+ * The scenario is simulated for every number of vehicles in --vehicles, and for every run it
+ * reports install time, route computation time, simulator events per second of wall-clock time,
+ * wall-clock time per simulated second, and memory per node in JSON format:
+ *
+ *     ./waf --run "ndn-vanet-benchmark --vehicles=250,500,1000,2000 --out=scaling.json"
+ *
+ * Memory is the exact number of live bytes allocated by the nodes when ndnSIM is configured with
+ * --enable-mem-accounting, otherwise it is the growth of the resident set size of the process
+ * (which underestimates later runs, as memory freed by the previous runs is reused).
+ */
+
+struct Parameters {
+  double simTime = 10.0;      // seconds
+  double spacing = 50.0;      // meters between vehicles in a lane
+  uint32_t nLanes = 4;        // half of them in each direction
+  double rsuSpacing = 1000.0; // meters
+  double consumers = 0.2;     // fraction of vehicles
+  double emergency = 0.01;    // fraction of vehicles
+  double frequency = 2.0;     // Interests per second of each consumer
+  uint32_t nContents = 1000;
+  uint32_t csSize = 1000;
+};
+
+struct Report {
+  uint32_t nVehicles;
+  uint32_t nRsus;
+  double installTime;
+  double routeTime;
+  double runTime;
+  uint64_t nEvents;
+  int64_t memory;
+  bool isMemoryAccounted;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+static double
+SecondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static int64_t
+GetNodeMemory(const NodeContainer& nodes)
+{
+  int64_t nBytes = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    for (int subsystem = 0; subsystem < ndn::MemAccounting::N_SUBSYSTEMS; subsystem++) {
+      nBytes += ndn::MemAccounting::GetCounters((*node)->GetId(),
+                                                static_cast<ndn::MemAccounting::Subsystem>(
+                                                  subsystem)).nBytes;
+    }
+  }
+  return nBytes;
+}
+
+static void
+InstallWave(const NodeContainer& nodes)
+{
+  YansWifiChannelHelper waveChannel = YansWifiChannelHelper::Default();
+  YansWavePhyHelper wavePhy = YansWavePhyHelper::Default();
+  wavePhy.SetChannel(waveChannel.Create());
+
+  QosWaveMacHelper waveMac = QosWaveMacHelper::Default();
+  WaveHelper waveHelper = WaveHelper::Default();
+  NetDeviceContainer devices = waveHelper.Install(wavePhy, waveMac, nodes);
+
+  // WaveNetDevice sends only on a channel with assigned access and registered profile
+  for (NetDeviceContainer::Iterator device = devices.Begin(); device != devices.End(); ++device) {
+    Ptr<WaveNetDevice> wave = DynamicCast<WaveNetDevice>(*device);
+    Simulator::Schedule(Seconds(0), &WaveNetDevice::StartSch, wave,
+                        SchInfo(SCH1, false, EXTENDED_ALTERNATING));
+    Simulator::Schedule(Seconds(0), &WaveNetDevice::RegisterTxProfile, wave, TxProfile(SCH1));
+  }
+}
+
+static void
+InstallMobility(const NodeContainer& vehicles, const NodeContainer& rsus, double length,
+                const Parameters& parameters)
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+  mobility.Install(vehicles);
+  for (uint32_t i = 0; i < vehicles.GetN(); i++) {
+    // lanes with even numbers go east, odd go west
+    uint32_t lane = i % parameters.nLanes;
+    double direction = lane % 2 == 0 ? 1.0 : -1.0;
+
+    Ptr<ConstantVelocityMobilityModel> model =
+      vehicles.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+    model->SetPosition(Vector(random->GetValue(0, length), 5.0 * lane, 0));
+    model->SetVelocity(Vector(direction * random->GetValue(20, 35), 0, 0));
+  }
+
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+  mobility.Install(rsus);
+  for (uint32_t i = 0; i < rsus.GetN(); i++) {
+    rsus.Get(i)->GetObject<MobilityModel>()->SetPosition(
+      Vector(parameters.rsuSpacing * (i + 0.5), -10.0, 0));
+  }
+}
+
+static Report
+Run(uint32_t nVehicles, const Parameters& parameters)
+{
+  Report report = {};
+  report.nVehicles = nVehicles;
+
+  double length = std::max(parameters.rsuSpacing,
+                           nVehicles * parameters.spacing / parameters.nLanes);
+  report.nRsus = static_cast<uint32_t>(std::ceil(length / parameters.rsuSpacing));
+
+  int64_t initialMemory = MemUsage::Get();
+  Clock::time_point start = Clock::now();
+
+  NodeContainer vehicles;
+  vehicles.Create(nVehicles);
+  NodeContainer rsus;
+  rsus.Create(report.nRsus);
+  NodeContainer nodes(vehicles, rsus);
+
+  InstallWave(nodes);
+  InstallMobility(vehicles, rsus, length, parameters);
+
+  PointToPointHelper backbone;
+  backbone.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  backbone.SetChannelAttribute("Delay", StringValue("1ms"));
+  for (uint32_t i = 1; i < rsus.GetN(); i++) {
+    backbone.Install(rsus.Get(i - 1), rsus.Get(i));
+  }
+
+  // attribute memory of stacks and applications to nodes; no records are written, totals are
+  // read after the run
+  ndn::MemAccounting::Enable();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.setCsSize(parameters.csSize);
+  ndnHelper.Install(nodes);
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/content");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(rsus);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrot");
+  consumerHelper.SetPrefix("/content");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(parameters.frequency));
+  consumerHelper.SetAttribute("NumberOfContents",
+                              StringValue(std::to_string(parameters.nContents)));
+  consumerHelper.SetAttribute("Randomize", StringValue("uniform"));
+
+  // pushing vehicles also serve Interests for their own emergency prefix only
+  ndn::AppHelper pushHelper("ns3::ndn::ProducerPush");
+  pushHelper.SetAttribute("EmergencyInd", StringValue("emergency"));
+  pushHelper.SetAttribute("PayloadSize", StringValue("200"));
+  pushHelper.SetAttribute("Randomize", StringValue("uniform"));
+
+  for (uint32_t i = 0; i < vehicles.GetN(); i++) {
+    double choice = random->GetValue();
+    if (choice < parameters.emergency) {
+      std::string name = "/emergency/" + std::to_string(vehicles.Get(i)->GetId());
+      pushHelper.SetPrefix(name);
+      pushHelper.SetAttribute("DataName", StringValue(name));
+      pushHelper.Install(vehicles.Get(i));
+    }
+    else if (choice < parameters.emergency + parameters.consumers) {
+      consumerHelper.Install(vehicles.Get(i));
+    }
+  }
+  report.installTime = SecondsSince(start);
+
+  start = Clock::now();
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.Install(nodes);
+  routingHelper.AddOrigins("/content", rsus);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  report.routeTime = SecondsSince(start);
+
+  Simulator::Stop(Seconds(parameters.simTime));
+
+  uint64_t nEvents = Simulator::GetEventCount();
+  start = Clock::now();
+  Simulator::Run();
+  report.runTime = SecondsSince(start);
+  report.nEvents = Simulator::GetEventCount() - nEvents;
+
+  report.isMemoryAccounted = ndn::MemAccounting::IsCounting();
+  report.memory = report.isMemoryAccounted ? GetNodeMemory(nodes)
+                                           : MemUsage::Get() - initialMemory;
+
+  Simulator::Destroy();
+  Names::Clear();
+  ndn::GlobalRouter::clear();
+
+  return report;
+}
+
+static void
+PrintJson(std::ostream& os, const Parameters& parameters, const std::vector<Report>& reports)
+{
+  os << "{\n"
+     << "  \"simulated_time_s\": " << parameters.simTime << ",\n"
+     << "  \"memory_source\": \""
+     << (ndn::MemAccounting::IsCounting() ? "mem-accounting" : "rss") << "\",\n"
+     << "  \"runs\": [";
+
+  for (size_t i = 0; i < reports.size(); i++) {
+    const Report& report = reports[i];
+    uint32_t nNodes = report.nVehicles + report.nRsus;
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\n"
+       << "      \"vehicles\": " << report.nVehicles << ",\n"
+       << "      \"rsus\": " << report.nRsus << ",\n"
+       << "      \"install_time_s\": " << report.installTime << ",\n"
+       << "      \"route_time_s\": " << report.routeTime << ",\n"
+       << "      \"wall_time_s\": " << report.runTime << ",\n"
+       << "      \"wall_time_per_simulated_s\": " << report.runTime / parameters.simTime << ",\n"
+       << "      \"events\": " << report.nEvents << ",\n"
+       << "      \"events_per_s\": " << report.nEvents / std::max(report.runTime, 1e-9) << ",\n"
+       << "      \"memory_bytes\": " << report.memory << ",\n"
+       << "      \"memory_per_node_bytes\": " << report.memory / static_cast<int64_t>(nNodes)
+       << "\n"
+       << "    }";
+  }
+  os << "\n  ]\n"
+     << "}\n";
+}
+
+int
+main(int argc, char* argv[])
+{
+  Parameters parameters;
+  std::string vehicles = "250,500,1000,2000";
+  std::string out = "-";
+  uint32_t run = 1;
+
+  CommandLine cmd;
+  cmd.AddValue("vehicles", "Comma-separated numbers of vehicles to simulate", vehicles);
+  cmd.AddValue("sim-time", "Simulated time of each run (seconds)", parameters.simTime);
+  cmd.AddValue("lanes", "Number of highway lanes (half in each direction)", parameters.nLanes);
+  cmd.AddValue("spacing", "Average distance between vehicles in a lane (meters)",
+               parameters.spacing);
+  cmd.AddValue("rsu-spacing", "Distance between RSUs (meters)", parameters.rsuSpacing);
+  cmd.AddValue("consumers", "Fraction of vehicles requesting content", parameters.consumers);
+  cmd.AddValue("emergency", "Fraction of vehicles pushing emergency Data", parameters.emergency);
+  cmd.AddValue("frequency", "Interests per second of each consumer", parameters.frequency);
+  cmd.AddValue("contents", "Number of contents (Zipf-Mandelbrot)", parameters.nContents);
+  cmd.AddValue("cs-size", "Maximum number of cached packets per node", parameters.csSize);
+  cmd.AddValue("run", "Run number of the random number generator", run);
+  cmd.AddValue("out", "File to write JSON report to (- for standard output)", out);
+  cmd.Parse(argc, argv);
+
+  std::vector<std::string> sizes;
+  boost::split(sizes, vehicles, boost::is_any_of(","), boost::token_compress_on);
+
+  std::vector<Report> reports;
+  for (const std::string& size : sizes) {
+    if (size.empty())
+      continue;
+
+    // the same placement and traffic for each run of the sweep
+    RngSeedManager::SetRun(run);
+
+    reports.push_back(Run(boost::lexical_cast<uint32_t>(size), parameters));
+
+    const Report& report = reports.back();
+    std::cerr << report.nVehicles << " vehicles, " << report.nRsus << " RSUs: install "
+              << report.installTime << " s, routes " << report.routeTime << " s, run "
+              << report.runTime << " s (" << report.nEvents << " events)" << std::endl;
+  }
+
+  if (out == "-") {
+    PrintJson(std::cout, parameters, reports);
+  }
+  else {
+    std::ofstream os(out.c_str());
+    if (!os.is_open()) {
+      NS_FATAL_ERROR("File " << out << " cannot be opened for writing");
+    }
+    PrintJson(os, parameters, reports);
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -20,31 +20,39 @@
 
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/graph/graph_utility.hpp>
-
-#include "ns3/ndnSIM/helper/boost-graph-ndn-global-routing-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
 #include "ns3/ndnSIM/helper/lfid/abstract-fib.hpp"
 #include "ns3/ndnSIM/helper/lfid/remove-loops.hpp"
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
 #include "ns3/ndnSIM/model/ndn-global-router.hpp"
 
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelperLfid");
 
 namespace ns3 {
 namespace ndn {
 
-using std::get;
 using std::unordered_map;
 
 void
 GlobalRoutingHelper::CalculateLfidRoutes()
 {
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  // Snapshot of the graph with distances from all nodes:
+  GlobalRoutingGraph graph;
 
-  // Creates graph from nodeList:
-  boost::NdnGlobalRouterGraph graph{};
+  std::vector<uint32_t> sources;
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+    if (graph.GetRouter(vertex)->GetObject<ns3::Node>() != nullptr)
+      sources.push_back(vertex);
+  }
+  graph.CacheDistances(sources, m_nThreads);
 
   AbstractFib::AllNodeFib allNodeFIB;
 
@@ -64,89 +72,63 @@ GlobalRoutingHelper::CalculateLfidRoutes()
       continue;
     }
 
-    // map: neighborId -> DistancesMap
-    unordered_map<int, boost::DistancesMap> nbSp;
-
-    // map: Destination (GlobalRouter) -> Distance
-    boost::DistancesMap distMap;
-    unordered_map<int, boost::DistancesMap> neighborSpMap;
+    uint32_t sourceVertex = graph.GetVertex(source);
+    const std::vector<uint32_t>& distances = graph.GetDistances(sourceVertex);
+
+    // 1. Get all neighbors of node, with their distances to all destinations.
+    // Distances from neighbors must not go back through the node: they are derived from the cached
+    // shortest path trees of the neighbors, recalculating only the paths through the node (instead
+    // of masking the links of the node and running Dijkstra for every neighbor).
+    struct Neighbor {
+      int id;
+      uint32_t metric;
+      const std::vector<uint32_t>* distances;
+      unordered_map<uint32_t, uint32_t> changed;
+    };
+    std::vector<Neighbor> neighbors;
 
-    dijkstra_shortest_paths(graph, source,
-                            distance_map(boost::ref(distMap))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // 1. Get all neighbors of node.
-    unordered_map<nfd::FaceId, uint64_t> originalMetrics;
     auto& originalFace = faceMap[nodeId];
-
-    const GlobalRouter::IncidencyList& neighbors = source->GetIncidencies();
-    // Set link weight of all neighbors to infinity
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
+    for (uint32_t edge = graph.GetEdgesBegin(sourceVertex); edge < graph.GetEdgesEnd(sourceVertex);
+         edge++) {
+      uint32_t nbVertex = graph.GetTarget(edge);
+      int nbId = graph.GetRouter(nbVertex)->GetObject<ns3::Node>()->GetId();
       NS_ABORT_UNLESS(nbId != nodeId);
 
-      auto& face = get<shared_ptr<Face>>(neighbor);
+      auto& face = graph.GetFace(edge);
       NS_ABORT_UNLESS(face != nullptr);
 
-      originalMetrics[nbId] = face->getMetric();
       originalFace[nbId] = face; // Is only a copy
-      face->setMetric(get<uint16_t>(boost::WeightInf));
-    }
-
-    // 2. Calculate Dijkstra for neighbors
-    for (const auto& neighbor : neighbors) {
-      const auto& nSource = get<0>(neighbor);
-      const auto& target = get<2>(neighbor);
-
-      int nbId = target->GetObject<ns3::Node>()->GetId();
-      Ptr<GlobalRouter> nbRouter = target;
-
-      NS_ABORT_UNLESS(target != source && nbId != nodeId);
-      NS_ABORT_UNLESS(nSource == source);
-
-      dijkstra_shortest_paths(graph, nbRouter,
-                              distance_map(boost::ref(neighborSpMap[nbId]))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+      neighbors.push_back(Neighbor{nbId, graph.GetWeight(edge), &graph.GetDistances(nbVertex), {}});
+      graph.GetDistancesWithout(nbVertex, sourceVertex, neighbors.back().changed);
     }
 
-    // 3. Reset link weights
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      NS_ABORT_UNLESS(nbId != nodeId);
-
-      const auto& face = get<shared_ptr<Face>>(neighbor);
-      NS_ABORT_UNLESS(face->getMetric() == get<uint16_t>(boost::WeightInf));
-      face->setMetric(originalMetrics.at(nbId));
-    }
-
-    // 4. Fill Abstract FIB:
+    // 2. Fill Abstract FIB:
     // For each destination:
-    for (const auto& dstEntry : distMap) {
-      Ptr<GlobalRouter> dstRouter = dstEntry.first;
-      int dstId = dstRouter->GetObject<ns3::Node>()->GetId();
-      if (dstRouter == source)
+    for (uint32_t dstVertex : sources) {
+      if (dstVertex == sourceVertex)
         continue; // Skip destination == source.
+      if (distances[dstVertex] == GlobalRoutingGraph::UNREACHABLE)
+        continue;
 
-      int spTotalCost = static_cast<int>(get<uint32_t>(dstEntry.second));
+      int dstId = graph.GetRouter(dstVertex)->GetObject<ns3::Node>()->GetId();
+      int spTotalCost = static_cast<int>(distances[dstVertex]);
 
       // For each neighbor:
-      for (const auto& nb : neighborSpMap) {
-        int neighborId = nb.first;
-        const uint32_t nbDist{get<uint32_t>(nb.second.at(dstRouter))};
+      for (const auto& nb : neighbors) {
+        int neighborId = nb.id;
+        auto changed = nb.changed.find(dstVertex);
+        const uint32_t nbDist{changed != nb.changed.end() ? changed->second
+                                                          : (*nb.distances)[dstVertex]};
+        if (nbDist == GlobalRoutingGraph::UNREACHABLE)
+          continue;
 
         int neighborCost = static_cast<int>(nbDist);
-        int neighborTotalCost = neighborCost + static_cast<int>(originalFace.at(neighborId)->getMetric());
+        int neighborTotalCost = neighborCost + static_cast<int>(nb.metric);
 
         NS_ABORT_UNLESS(neighborTotalCost >= spTotalCost);
 
         // Skip routers that would loop back
-        if (neighborTotalCost >= static_cast<int>(get<uint16_t>(boost::WeightInf)))
+        if (neighborTotalCost >= std::numeric_limits<uint16_t>::max())
           continue;
 
         NextHopType nbType;
@@ -174,9 +156,13 @@ GlobalRoutingHelper::CalculateLfidRoutes()
 
   // 5. Insert from AbsFIB into real FIB!
   // For each node in the AbsFIB: Insert into real fib.
+  // Loop removal needs FIBs of all nodes, but in distributed simulations only nodes simulated by
+  // this rank get FIB entries.
   for (const auto& nodeEntry : allNodeFIB) {
     int nodeId = nodeEntry.first;
     const auto& fib = nodeEntry.second;
+    if (!IsLocal(NodeList::GetNode(static_cast<uint32_t>(nodeId))))
+      continue;
 
     // For each destination:
     for (const auto& dst : fib) {
@@ -24,6 +24,7 @@
 
 #include "apps/ndn-app.hpp"
 #include "ndn-stack-helper.hpp"
+#include "utils/ndn-mem-accounting.hpp"
 
 #ifdef NS3_MPI
 #include "ns3/mpi-interface.h"
@@ -94,6 +95,7 @@ AppHelper::InstallPriv(Ptr<Node> node)
         }
 #endif
 
+        MemAccounting::Scope scope(MemAccounting::APP, node->GetId());
         app = m_factory.Create<Application>();
         node->AddApplication(app);
       }));
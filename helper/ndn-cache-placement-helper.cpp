@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-cache-placement-helper.hpp"
+#include "ndn-cs-snapshot-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/channel.h"
+#include "ns3/double.h"
+#include "ns3/net-device.h"
+
+#include "model/cs/ndn-content-store.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CachePlacementHelper");
+
+namespace ns3 {
+namespace ndn {
+
+std::map<uint32_t, double>
+CachePlacementHelper::ComputeBetweenness(const NodeContainer& nodes)
+{
+  // index nodes and build adjacency lists from the channels between them
+  std::map<uint32_t, size_t> index;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    index.emplace((*node)->GetId(), index.size());
+  }
+
+  std::vector<std::vector<size_t>> neighbors(index.size());
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    size_t self = index[(*node)->GetId()];
+    std::set<size_t> adjacent;
+
+    for (uint32_t deviceId = 0; deviceId < (*node)->GetNDevices(); deviceId++) {
+      Ptr<Channel> channel = (*node)->GetDevice(deviceId)->GetChannel();
+      if (channel == 0)
+        continue;
+
+      for (size_t i = 0; i < channel->GetNDevices(); i++) {
+        auto other = index.find(channel->GetDevice(i)->GetNode()->GetId());
+        if (other != index.end() && other->second != self)
+          adjacent.insert(other->second);
+      }
+    }
+    neighbors[self].assign(adjacent.begin(), adjacent.end());
+  }
+
+  // Brandes' algorithm for unweighted graphs
+  size_t n = neighbors.size();
+  std::vector<double> centrality(n, 0.0);
+  std::vector<size_t> order;
+  std::vector<std::vector<size_t>> predecessors(n);
+  std::vector<double> nPaths(n);
+  std::vector<int64_t> distance(n);
+  std::vector<double> dependency(n);
+
+  for (size_t source = 0; source < n; source++) {
+    order.clear();
+    for (size_t v = 0; v < n; v++) {
+      predecessors[v].clear();
+    }
+    std::fill(nPaths.begin(), nPaths.end(), 0.0);
+    std::fill(distance.begin(), distance.end(), -1);
+    std::fill(dependency.begin(), dependency.end(), 0.0);
+
+    nPaths[source] = 1.0;
+    distance[source] = 0;
+    std::deque<size_t> queue(1, source);
+    while (!queue.empty()) {
+      size_t v = queue.front();
+      queue.pop_front();
+      order.push_back(v);
+
+      for (size_t w : neighbors[v]) {
+        if (distance[w] < 0) {
+          distance[w] = distance[v] + 1;
+          queue.push_back(w);
+        }
+        if (distance[w] == distance[v] + 1) {
+          nPaths[w] += nPaths[v];
+          predecessors[w].push_back(v);
+        }
+      }
+    }
+
+    for (auto w = order.rbegin(); w != order.rend(); w++) {
+      for (size_t v : predecessors[*w]) {
+        dependency[v] += nPaths[v] / nPaths[*w] * (1.0 + dependency[*w]);
+      }
+      if (*w != source)
+        centrality[*w] += dependency[*w];
+    }
+  }
+
+  double maxCentrality = 0.0;
+  for (double value : centrality) {
+    maxCentrality = std::max(maxCentrality, value);
+  }
+
+  std::map<uint32_t, double> betweenness;
+  for (const auto& node : index) {
+    betweenness[node.first] = maxCentrality > 0.0 ? centrality[node.second] / maxCentrality : 0.0;
+  }
+  return betweenness;
+}
+
+void
+CachePlacementHelper::InstallBetweenness()
+{
+  InstallBetweenness(NodeContainer::GetGlobal());
+}
+
+void
+CachePlacementHelper::InstallBetweenness(const NodeContainer& nodes)
+{
+  std::map<uint32_t, double> betweenness = ComputeBetweenness(nodes);
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<ContentStore> store = (*node)->GetObject<ContentStore>();
+    if (store == 0)
+      continue;
+
+    double value = betweenness[(*node)->GetId()];
+    if (!store->SetAttributeFailSafe("Betweenness", DoubleValue(value))) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << ": content store does not use betweenness");
+      continue;
+    }
+    NS_LOG_DEBUG("Node " << (*node)->GetId() << ": betweenness " << value);
+  }
+}
+
+CachePlacementHelper::Redundancy
+CachePlacementHelper::MeasureRedundancy()
+{
+  return MeasureRedundancy(NodeContainer::GetGlobal());
+}
+
+CachePlacementHelper::Redundancy
+CachePlacementHelper::MeasureRedundancy(const NodeContainer& nodes)
+{
+  Redundancy redundancy;
+  std::set<Name> names;
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    CsSnapshotHelper::NodeSnapshot content = CsSnapshotHelper::GetContent(*node);
+    if (content.empty())
+      continue;
+
+    redundancy.nNodes++;
+    redundancy.nCopies += content.size();
+    for (const auto& data : content) {
+      names.insert(data->getName());
+    }
+  }
+
+  redundancy.nDistinct = names.size();
+  return redundancy;
+}
+
+} // namespace ndn
+} // namespace ns3
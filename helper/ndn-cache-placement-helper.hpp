@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CACHE_PLACEMENT_HELPER_HPP
+#define NDN_CACHE_PLACEMENT_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper for path-aware cache placement (ns3::ndn::cs::Placement::* content stores)
+ *
+ * Computes topology properties that placement strategies depend on and measures how
+ * placement decisions spread Data across content stores of the network.
+ */
+class CachePlacementHelper {
+public:
+  /**
+   * @brief Network-wide cache redundancy
+   */
+  struct Redundancy {
+    size_t nNodes = 0;    ///< number of nodes with at least one cached Data
+    size_t nDistinct = 0; ///< number of distinct Data names cached anywhere
+    size_t nCopies = 0;   ///< total number of cached Data, over all nodes
+
+    /**
+     * @brief Average number of copies of each cached Data (1 means no redundancy)
+     */
+    double
+    GetRatio() const
+    {
+      return nDistinct == 0 ? 0.0 : static_cast<double>(nCopies) / nDistinct;
+    }
+  };
+
+  /**
+   * @brief Compute betweenness centrality of the nodes, normalized to [0, 1]
+   *
+   * The graph is formed by channels that connect the nodes (nodes outside of the container are
+   * ignored) and shortest paths are counted in hops.  The most central node gets 1.
+   *
+   * @returns map from node ID to normalized betweenness
+   */
+  static std::map<uint32_t, double>
+  ComputeBetweenness(const NodeContainer& nodes);
+
+  /**
+   * @brief Set Betweenness attribute of the content stores of all nodes
+   */
+  static void
+  InstallBetweenness();
+
+  /**
+   * @brief Set Betweenness attribute of the content stores of the nodes, computed over the
+   *        subgraph that the nodes form
+   *
+   * Nodes that do not use a content store with the attribute are skipped.
+   */
+  static void
+  InstallBetweenness(const NodeContainer& nodes);
+
+  /**
+   * @brief Count copies of the cached Data in content stores of all nodes
+   */
+  static Redundancy
+  MeasureRedundancy();
+
+  /**
+   * @brief Count copies of the cached Data in content stores of the nodes
+   *
+   * Both ndnSIM 1.0 content stores (SetOldContentStore) and NFD's content store are counted.
+   */
+  static Redundancy
+  MeasureRedundancy(const NodeContainer& nodes);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CACHE_PLACEMENT_HELPER_HPP
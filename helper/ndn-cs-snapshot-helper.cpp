@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-cs-snapshot-helper.hpp"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/table/cs.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CsSnapshotHelper");
+
+namespace ns3 {
+namespace ndn {
+
+static const char SNAPSHOT_MAGIC[8] = {'n', 'd', 'n', 'S', 'I', 'M', 'c', 's'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+static void
+writeUint32(std::ostream& os, uint32_t value)
+{
+  char buf[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                 static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)};
+  os.write(buf, sizeof(buf));
+}
+
+static uint32_t
+checkedUint32(size_t value)
+{
+  NS_ABORT_MSG_IF(value > std::numeric_limits<uint32_t>::max(),
+                  "Value " << value << " does not fit into content store snapshot");
+  return static_cast<uint32_t>(value);
+}
+
+static uint32_t
+readUint32(std::istream& is)
+{
+  unsigned char buf[4] = {0, 0, 0, 0};
+  is.read(reinterpret_cast<char*>(buf), sizeof(buf));
+  return static_cast<uint32_t>(buf[0]) | (static_cast<uint32_t>(buf[1]) << 8)
+         | (static_cast<uint32_t>(buf[2]) << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+CsSnapshotHelper::NodeSnapshot
+CsSnapshotHelper::GetContent(Ptr<Node> node)
+{
+  NodeSnapshot content;
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  if (ndn == nullptr)
+    return content;
+
+  Ptr<ContentStore> cs = ndn->GetObject<ContentStore>();
+  if (cs != nullptr) {
+    for (const auto& entry : cs->GetEntriesInPolicyOrder()) {
+      content.push_back(entry->GetData());
+    }
+  }
+  else {
+    const ::nfd::Cs& nfdCs = ndn->getForwarder()->getCs();
+    content.reserve(nfdCs.size());
+    for (const auto& entry : nfdCs) {
+      content.push_back(entry.getData().shared_from_this());
+    }
+  }
+
+  return content;
+}
+
+void
+CsSnapshotHelper::Preload(Ptr<Node> node, const NodeSnapshot& content)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != nullptr, "NDN stack should be installed before preloading content store");
+
+  Ptr<ContentStore> cs = ndn->GetObject<ContentStore>();
+  if (cs != nullptr) {
+    for (const auto& data : content) {
+      cs->Add(data);
+    }
+  }
+  else {
+    ::nfd::Cs& nfdCs = ndn->getForwarder()->getCs();
+    for (const auto& data : content) {
+      nfdCs.insert(*data);
+    }
+  }
+
+  NS_LOG_DEBUG("Node " << node->GetId() << ": preloaded " << content.size() << " Data");
+}
+
+void
+CsSnapshotHelper::Save(const std::string& file)
+{
+  Save(NodeContainer::GetGlobal(), file);
+}
+
+void
+CsSnapshotHelper::Save(const NodeContainer& nodes, const std::string& file)
+{
+  Snapshot snapshot;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    snapshot[(*node)->GetId()] = GetContent(*node);
+  }
+
+  Write(snapshot, file);
+}
+
+void
+CsSnapshotHelper::Write(const Snapshot& snapshot, const std::string& file)
+{
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Snapshot is not saved");
+    return;
+  }
+
+  os.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  writeUint32(os, SNAPSHOT_VERSION);
+  writeUint32(os, checkedUint32(snapshot.size()));
+
+  size_t nEntries = 0;
+  for (const auto& nodeContent : snapshot) {
+    writeUint32(os, nodeContent.first);
+    writeUint32(os, checkedUint32(nodeContent.second.size()));
+    for (const auto& data : nodeContent.second) {
+      const Block& wire = data->wireEncode();
+      writeUint32(os, checkedUint32(wire.size()));
+      os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+    }
+    nEntries += nodeContent.second.size();
+  }
+
+  NS_LOG_INFO("Saved " << nEntries << " content store entries of " << snapshot.size()
+                       << " nodes to " << file);
+}
+
+void
+CsSnapshotHelper::ScheduleSave(Time when, const std::string& file)
+{
+  void (*save)(const std::string&) = &CsSnapshotHelper::Save;
+  Simulator::Schedule(when, save, file);
+}
+
+CsSnapshotHelper::Snapshot
+CsSnapshotHelper::Read(const std::string& file)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("Content store snapshot " << file << " cannot be opened for reading");
+  }
+
+  char magic[sizeof(SNAPSHOT_MAGIC)];
+  is.read(magic, sizeof(magic));
+  if (!is || !std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC)) {
+    NS_FATAL_ERROR(file << " is not a content store snapshot");
+  }
+
+  uint32_t version = readUint32(is);
+  if (!is) {
+    NS_FATAL_ERROR("Content store snapshot " << file << " is truncated");
+  }
+  if (version != SNAPSHOT_VERSION) {
+    NS_FATAL_ERROR("Unsupported version " << version << " of content store snapshot " << file);
+  }
+
+  // counts and sizes are checked against the rest of the file before anything is allocated, so
+  // that a truncated or corrupted snapshot is reported instead of exhausting memory
+  const std::streampos start = is.tellg();
+  is.seekg(0, std::ios_base::end);
+  const uint64_t fileSize = static_cast<uint64_t>(is.tellg());
+  is.seekg(start);
+
+  auto getRemaining = [&] {
+    return fileSize - static_cast<uint64_t>(is.tellg());
+  };
+  auto readChecked = [&] {
+    uint32_t value = readUint32(is);
+    if (!is) {
+      NS_FATAL_ERROR("Content store snapshot " << file << " is truncated");
+    }
+    return value;
+  };
+  auto checkCount = [&](uint64_t count, uint64_t minItemSize) {
+    if (count > getRemaining() / minItemSize) {
+      NS_FATAL_ERROR("Content store snapshot " << file << " is corrupted: " << count
+                     << " items do not fit into the rest of the file");
+    }
+  };
+
+  Snapshot snapshot;
+  std::vector<uint8_t> buffer;
+
+  uint32_t nNodes = readChecked();
+  checkCount(nNodes, 2 * sizeof(uint32_t));
+  for (uint32_t i = 0; i < nNodes; i++) {
+    uint32_t nodeId = readChecked();
+    uint32_t nEntries = readChecked();
+    checkCount(nEntries, sizeof(uint32_t));
+
+    NodeSnapshot& content = snapshot[nodeId];
+    content.reserve(nEntries);
+    for (uint32_t j = 0; j < nEntries; j++) {
+      uint32_t size = readChecked();
+      checkCount(size, 1);
+
+      buffer.resize(size);
+      is.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+      if (!is) {
+        NS_FATAL_ERROR("Content store snapshot " << file << " is truncated");
+      }
+
+      try {
+        content.push_back(make_shared<Data>(Block(buffer.data(), buffer.size())));
+      }
+      catch (const ::ndn::tlv::Error& e) {
+        NS_FATAL_ERROR("Content store snapshot " << file << " contains malformed Data of node "
+                       << nodeId << ": " << e.what());
+      }
+    }
+  }
+
+  return snapshot;
+}
+
+void
+CsSnapshotHelper::Load(const std::string& file)
+{
+  Snapshot snapshot = Read(file);
+
+  for (const auto& nodeContent : snapshot) {
+    if (nodeContent.first >= NodeList::GetNNodes()) {
+      NS_LOG_WARN("Node " << nodeContent.first << " from snapshot does not exist, skipping");
+      continue;
+    }
+
+    Ptr<Node> node = NodeList::GetNode(nodeContent.first);
+    if (node->GetObject<L3Protocol>() == nullptr) {
+      NS_LOG_WARN("NDN stack is not installed on node " << nodeContent.first << ", skipping");
+      continue;
+    }
+
+    Preload(node, nodeContent.second);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CS_SNAPSHOT_HELPER_HPP
+#define NDN_CS_SNAPSHOT_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to dump content stores of simulation nodes to a file and to preload them back
+ *
+ * The snapshot is a compact binary file that, for every node (identified by its ID), contains
+ * wire-encoded Data packets in the order of the node's cache replacement policy (first to be
+ * evicted first).  Preloading re-inserts the Data in the same order, so the warmed up cache
+ * state is restored without simulating the warm-up period.
+ *
+ * Both ndnSIM 1.0 content stores (SetOldContentStore) and NFD's content store are supported.
+ * For NFD's content store the policy order is not exposed and Data are saved in name order.
+ *
+ * Only the Data packets and their order are saved.  Preloaded entries are treated as if they
+ * were received at the preload time: their FreshnessPeriod starts anew, and policy state other
+ * than the order (e.g., access frequencies of the LFU policy) starts from the initial values.
+ *
+ * Example:
+ *
+ *     // run 1: dump content stores after 60 seconds of simulated time
+ *     ndn::CsSnapshotHelper::ScheduleSave(Seconds(60.0), "cs-snapshot.bin");
+ *
+ *     // run 2: start with warmed up caches
+ *     ndnHelper.setCsSnapshot("cs-snapshot.bin");
+ *     ndnHelper.InstallAll();
+ */
+class CsSnapshotHelper {
+public:
+  typedef std::vector<shared_ptr<const Data>> NodeSnapshot;
+  typedef std::map<uint32_t, NodeSnapshot> Snapshot;
+
+  /**
+   * @brief Save content stores of all nodes into the file
+   */
+  static void
+  Save(const std::string& file);
+
+  /**
+   * @brief Save content stores of the selected nodes into the file
+   */
+  static void
+  Save(const NodeContainer& nodes, const std::string& file);
+
+  /**
+   * @brief Schedule saving of content stores of all nodes at the specified simulation time
+   */
+  static void
+  ScheduleSave(Time when, const std::string& file);
+
+  /**
+   * @brief Write snapshot into the file
+   */
+  static void
+  Write(const Snapshot& snapshot, const std::string& file);
+
+  /**
+   * @brief Read snapshot from the file
+   *
+   * Simulation is aborted if the file cannot be read or is malformed
+   */
+  static Snapshot
+  Read(const std::string& file);
+
+  /**
+   * @brief Read snapshot from the file and preload it into all nodes with installed NDN stack
+   */
+  static void
+  Load(const std::string& file);
+
+  /**
+   * @brief Get content of the node's content store in the replacement policy order
+   */
+  static NodeSnapshot
+  GetContent(Ptr<Node> node);
+
+  /**
+   * @brief Insert content into the node's content store, preserving the order
+   *
+   * Freshness and policy state of the inserted entries start from the insertion time
+   */
+  static void
+  Preload(Ptr<Node> node, const NodeSnapshot& content);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CS_SNAPSHOT_HELPER_HPP
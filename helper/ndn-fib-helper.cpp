@@ -41,6 +41,7 @@
 #include "daemon/mgmt/fib-manager.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/utils/ndn-mem-accounting.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -50,6 +51,8 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  MemAccounting::Scope scope(MemAccounting::FIB, node->GetId());
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
@@ -67,6 +70,8 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  MemAccounting::Scope scope(MemAccounting::FIB, node->GetId());
+
   Block encodedParameters(parameters.wireEncode());
 
   Name commandName("/localhost/nfd/fib");
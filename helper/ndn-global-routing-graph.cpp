@@ -0,0 +1,476 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingGraph");
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t GlobalRoutingGraph::INVALID;
+const uint32_t GlobalRoutingGraph::UNREACHABLE;
+
+namespace {
+
+typedef std::pair<uint32_t, uint32_t> Label;           // distance, first hop
+typedef std::tuple<uint32_t, uint32_t, uint32_t> Item; // distance, first hop, vertex
+
+Label
+GetLabel(const GlobalRoutingGraph::ShortestPaths& paths, uint32_t vertex)
+{
+  return Label(paths.distances[vertex], paths.firstHops[vertex]);
+}
+
+} // namespace
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_routers.push_back(gr);
+  }
+
+  m_vertices.reserve(m_routers.size());
+  for (uint32_t vertex = 0; vertex < m_routers.size(); vertex++) {
+    m_vertices[m_routers[vertex]->GetId()] = vertex;
+  }
+
+  m_offsets.reserve(m_routers.size() + 1);
+  for (const Ptr<GlobalRouter>& gr : m_routers) {
+    m_offsets.push_back(m_targets.size());
+
+    for (const auto& incidency : gr->GetIncidencies()) {
+      uint32_t target = GetVertex(std::get<2>(incidency));
+      if (target == INVALID)
+        continue;
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      m_sources.push_back(m_offsets.size() - 1);
+      m_targets.push_back(target);
+      m_weights.push_back(face != nullptr ? face->getMetric() : 0);
+      m_faces.push_back(face);
+    }
+  }
+  m_offsets.push_back(m_targets.size());
+  m_isUp.assign(m_targets.size(), true);
+
+  m_inOffsets.assign(m_routers.size() + 1, 0);
+  for (uint32_t target : m_targets) {
+    m_inOffsets[target + 1]++;
+  }
+  for (size_t vertex = 0; vertex < m_routers.size(); vertex++) {
+    m_inOffsets[vertex + 1] += m_inOffsets[vertex];
+  }
+  m_inEdges.resize(m_targets.size());
+  std::vector<uint32_t> position(m_inOffsets.begin(), m_inOffsets.end() - 1);
+  for (uint32_t edge = 0; edge < m_targets.size(); edge++) {
+    m_inEdges[position[m_targets[edge]]++] = edge;
+  }
+
+  NS_LOG_DEBUG("Snapshot with " << m_routers.size() << " vertices and " << m_targets.size()
+                                << " edges");
+}
+
+size_t
+GlobalRoutingGraph::GetNVertices() const
+{
+  return m_routers.size();
+}
+
+uint32_t
+GlobalRoutingGraph::GetVertex(const Ptr<GlobalRouter>& router) const
+{
+  auto vertex = m_vertices.find(router->GetId());
+  if (vertex == m_vertices.end())
+    return INVALID;
+  return vertex->second;
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingGraph::GetRouter(uint32_t vertex) const
+{
+  return m_routers[vertex];
+}
+
+uint32_t
+GlobalRoutingGraph::GetEdgesBegin(uint32_t vertex) const
+{
+  return m_offsets[vertex];
+}
+
+uint32_t
+GlobalRoutingGraph::GetEdgesEnd(uint32_t vertex) const
+{
+  return m_offsets[vertex + 1];
+}
+
+uint32_t
+GlobalRoutingGraph::GetTarget(uint32_t edge) const
+{
+  return m_targets[edge];
+}
+
+uint32_t
+GlobalRoutingGraph::GetWeight(uint32_t edge) const
+{
+  return m_weights[edge];
+}
+
+const shared_ptr<Face>&
+GlobalRoutingGraph::GetFace(uint32_t edge) const
+{
+  return m_faces[edge];
+}
+
+uint32_t
+GlobalRoutingGraph::FindEdge(uint32_t from, uint32_t to) const
+{
+  for (uint32_t edge = m_offsets[from]; edge < m_offsets[from + 1]; edge++) {
+    if (m_targets[edge] == to)
+      return edge;
+  }
+  return INVALID;
+}
+
+void
+GlobalRoutingGraph::SetEdgeUp(uint32_t edge, bool isUp)
+{
+  m_isUp[edge] = isUp;
+}
+
+bool
+GlobalRoutingGraph::IsEdgeUp(uint32_t edge) const
+{
+  return m_isUp[edge];
+}
+
+void
+GlobalRoutingGraph::CalculateShortestPaths(uint32_t source, ShortestPaths& paths) const
+{
+  paths.distances.assign(m_routers.size(), UNREACHABLE);
+  paths.firstHops.assign(m_routers.size(), INVALID);
+  paths.parents.assign(m_routers.size(), INVALID);
+
+  // vertices are labeled with (distance, first hop), so that among equal-cost paths the one with
+  // the lowest first hop is selected regardless of the order in which vertices are visited
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+
+  paths.distances[source] = 0;
+  queue.push(Item(0, INVALID, source));
+  while (!queue.empty()) {
+    Item item = queue.top();
+    queue.pop();
+
+    uint32_t vertex = std::get<2>(item);
+    if (Label(std::get<0>(item), std::get<1>(item)) != GetLabel(paths, vertex))
+      continue; // stale entry
+
+    for (uint32_t edge = m_offsets[vertex]; edge < m_offsets[vertex + 1]; edge++) {
+      if (!m_isUp[edge])
+        continue;
+
+      uint32_t target = m_targets[edge];
+      Label label(std::get<0>(item) + m_weights[edge], vertex == source ? edge : std::get<1>(item));
+      if (target == source || label >= GetLabel(paths, target))
+        continue;
+
+      paths.distances[target] = label.first;
+      paths.firstHops[target] = label.second;
+      paths.parents[target] = edge;
+      queue.push(Item(label.first, label.second, target));
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::UpdateShortestPaths(uint32_t source, uint32_t edge, ShortestPaths& paths,
+                                        PreviousPaths& previous) const
+{
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+
+  auto update = [&](uint32_t vertex, const Label& label, uint32_t parent) {
+    previous.emplace(vertex, std::make_pair(paths.firstHops[vertex], paths.distances[vertex]));
+
+    paths.distances[vertex] = label.first;
+    paths.firstHops[vertex] = label.second;
+    paths.parents[vertex] = parent;
+  };
+
+  // label of the path that ends with the edge (labels are the same as in CalculateShortestPaths)
+  auto extend = [&](uint32_t last) {
+    uint32_t vertex = m_sources[last];
+    return Label(paths.distances[vertex] + m_weights[last],
+                 vertex == source ? last : paths.firstHops[vertex]);
+  };
+
+  uint32_t from = m_sources[edge];
+  uint32_t to = m_targets[edge];
+
+  std::vector<bool> isAffected;
+  if (m_isUp[edge]) {
+    // edge up: only vertices that become closer through the edge are updated
+    if (paths.distances[from] == UNREACHABLE || to == source
+        || extend(edge) >= GetLabel(paths, to))
+      return;
+
+    update(to, extend(edge), edge);
+    queue.push(Item(paths.distances[to], paths.firstHops[to], to));
+  }
+  else {
+    // edge down: only the subtree below the edge is affected
+    if (paths.parents[to] != edge)
+      return;
+
+    isAffected.assign(m_routers.size(), false);
+    std::vector<uint32_t> subtree(1, to);
+    isAffected[to] = true;
+    for (size_t i = 0; i < subtree.size(); i++) {
+      for (uint32_t child = m_offsets[subtree[i]]; child < m_offsets[subtree[i] + 1]; child++) {
+        uint32_t target = m_targets[child];
+        if (paths.parents[target] == child && !isAffected[target]) {
+          isAffected[target] = true;
+          subtree.push_back(target);
+        }
+      }
+    }
+
+    for (uint32_t vertex : subtree) {
+      update(vertex, Label(UNREACHABLE, INVALID), INVALID);
+    }
+
+    // enter the subtree from the vertices that are not affected
+    for (uint32_t vertex : subtree) {
+      for (uint32_t i = m_inOffsets[vertex]; i < m_inOffsets[vertex + 1]; i++) {
+        uint32_t inEdge = m_inEdges[i];
+        uint32_t parent = m_sources[inEdge];
+        if (!m_isUp[inEdge] || isAffected[parent] || paths.distances[parent] == UNREACHABLE)
+          continue;
+
+        if (extend(inEdge) < GetLabel(paths, vertex))
+          update(vertex, extend(inEdge), inEdge);
+      }
+      if (paths.distances[vertex] != UNREACHABLE)
+        queue.push(Item(paths.distances[vertex], paths.firstHops[vertex], vertex));
+    }
+  }
+
+  while (!queue.empty()) {
+    Item item = queue.top();
+    queue.pop();
+
+    uint32_t vertex = std::get<2>(item);
+    if (Label(std::get<0>(item), std::get<1>(item)) != GetLabel(paths, vertex))
+      continue; // stale entry
+
+    for (uint32_t next = m_offsets[vertex]; next < m_offsets[vertex + 1]; next++) {
+      uint32_t target = m_targets[next];
+      if (!m_isUp[next] || target == source || (!isAffected.empty() && !isAffected[target]))
+        continue;
+
+      Label label = extend(next);
+      if (label < GetLabel(paths, target)) {
+        update(target, label, next);
+        queue.push(Item(label.first, label.second, target));
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::CacheDistances(const std::vector<uint32_t>& sources, uint32_t nThreads)
+{
+  m_distances.resize(m_routers.size());
+
+  std::vector<uint32_t> missing;
+  for (uint32_t source : sources) {
+    if (m_distances[source].empty()) {
+      missing.push_back(source);
+    }
+  }
+  std::sort(missing.begin(), missing.end());
+  missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+  NS_LOG_DEBUG("Calculating distances from " << missing.size() << " vertices");
+  RunParallel(missing.size(), nThreads, [this, &missing](size_t i) {
+    ShortestPaths paths;
+    CalculateShortestPaths(missing[i], paths);
+    m_distances[missing[i]].swap(paths.distances);
+  });
+}
+
+const std::vector<uint32_t>&
+GlobalRoutingGraph::GetDistances(uint32_t source) const
+{
+  NS_ASSERT_MSG(source < m_distances.size() && !m_distances[source].empty(),
+                "Distances from vertex " << source << " are not cached");
+  return m_distances[source];
+}
+
+void
+GlobalRoutingGraph::GetDistancesWithout(uint32_t source, uint32_t excluded,
+                                        std::unordered_map<uint32_t, uint32_t>& changed) const
+{
+  changed.clear();
+
+  const std::vector<uint32_t>& fromSource = GetDistances(source);
+  const std::vector<uint32_t>& fromExcluded = GetDistances(excluded);
+  if (fromSource[excluded] == UNREACHABLE)
+    return;
+
+  // only vertices with a shortest path through the excluded vertex can change
+  std::vector<uint32_t> candidates;
+  for (uint32_t vertex = 0; vertex < m_routers.size(); vertex++) {
+    if (vertex == source || vertex == excluded || fromExcluded[vertex] == UNREACHABLE)
+      continue;
+    if (static_cast<uint64_t>(fromSource[excluded]) + fromExcluded[vertex] == fromSource[vertex])
+      candidates.push_back(vertex);
+  }
+  if (candidates.empty())
+    return;
+
+  std::sort(candidates.begin(), candidates.end(), [&fromSource](uint32_t a, uint32_t b) {
+    return fromSource[a] < fromSource[b];
+  });
+
+  // a candidate keeps its distance if it has a shortest path edge from a vertex that keeps its
+  // distance; more than one pass is needed only with zero-weight edges
+  for (uint32_t vertex : candidates) {
+    changed[vertex] = UNREACHABLE;
+  }
+  for (bool isUpdated = true; isUpdated;) {
+    isUpdated = false;
+    for (uint32_t vertex : candidates) {
+      if (changed.count(vertex) == 0)
+        continue;
+
+      for (uint32_t i = m_inOffsets[vertex]; i < m_inOffsets[vertex + 1]; i++) {
+        uint32_t edge = m_inEdges[i];
+        uint32_t from = m_sources[edge];
+        if (!m_isUp[edge] || from == excluded || changed.count(from) != 0
+            || fromSource[from] == UNREACHABLE)
+          continue;
+
+        if (static_cast<uint64_t>(fromSource[from]) + m_weights[edge] == fromSource[vertex]) {
+          changed.erase(vertex);
+          isUpdated = true;
+          break;
+        }
+      }
+    }
+  }
+
+  // recalculate changed vertices, entering them from the vertices that kept their distances
+  typedef std::pair<uint32_t, uint32_t> Item; // distance, vertex
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  for (auto& entry : changed) {
+    uint32_t vertex = entry.first;
+    for (uint32_t i = m_inOffsets[vertex]; i < m_inOffsets[vertex + 1]; i++) {
+      uint32_t edge = m_inEdges[i];
+      uint32_t from = m_sources[edge];
+      if (!m_isUp[edge] || from == excluded || changed.count(from) != 0
+          || fromSource[from] == UNREACHABLE)
+        continue;
+
+      entry.second = std::min(entry.second, fromSource[from] + m_weights[edge]);
+    }
+    if (entry.second != UNREACHABLE)
+      queue.push(Item(entry.second, vertex));
+  }
+
+  while (!queue.empty()) {
+    Item item = queue.top();
+    queue.pop();
+
+    uint32_t vertex = item.second;
+    if (item.first > changed[vertex])
+      continue; // stale entry
+
+    for (uint32_t edge = m_offsets[vertex]; edge < m_offsets[vertex + 1]; edge++) {
+      auto target = changed.find(m_targets[edge]);
+      if (!m_isUp[edge] || target == changed.end())
+        continue; // removing edges cannot make other distances shorter
+
+      uint32_t distance = item.first + m_weights[edge];
+      if (distance < target->second) {
+        target->second = distance;
+        queue.push(Item(distance, target->first));
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::RunParallel(size_t nJobs, uint32_t nThreads,
+                                const std::function<void(size_t)>& job)
+{
+  if (nThreads == 0)
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = static_cast<uint32_t>(std::min<size_t>(nThreads, nJobs));
+
+  if (nThreads <= 1) {
+    for (size_t i = 0; i < nJobs; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&] {
+    for (size_t i = next++; i < nJobs; i = next++) {
+      job(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < nThreads; i++) {
+    threads.push_back(std::thread(worker));
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Compact snapshot of the GlobalRouter graph for shortest path calculations
+ *
+ * Vertices (GlobalRouter objects of nodes and multi-access channels) get consecutive integer IDs
+ * and edges are stored in compressed sparse row (CSR) form.  Face metrics are copied when the
+ * snapshot is taken, so shortest paths from different sources can be calculated in parallel.
+ */
+class GlobalRoutingGraph {
+public:
+  /// @brief Invalid vertex or edge ID
+  static const uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+  /// @brief Distance to unreachable vertices
+  static const uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Shortest paths from a single source
+   */
+  struct ShortestPaths {
+    std::vector<uint32_t> distances; ///< @brief distance to every vertex
+    std::vector<uint32_t> firstHops; ///< @brief first edge on the path to every vertex
+    std::vector<uint32_t> parents;   ///< @brief last edge on the path to every vertex
+  };
+
+  /**
+   * @brief Previous first hops and distances of the vertices updated by UpdateShortestPaths
+   */
+  typedef std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> PreviousPaths;
+
+  /**
+   * @brief Take snapshot of GlobalRouter objects installed on nodes and channels
+   */
+  GlobalRoutingGraph();
+
+  size_t
+  GetNVertices() const;
+
+  /**
+   * @brief Get vertex ID of the router, or INVALID if router is not in the snapshot
+   */
+  uint32_t
+  GetVertex(const Ptr<GlobalRouter>& router) const;
+
+  Ptr<GlobalRouter>
+  GetRouter(uint32_t vertex) const;
+
+  /**
+   * @brief Get first edge of the vertex (edges of the vertex are [GetEdgesBegin(v), GetEdgesEnd(v)))
+   */
+  uint32_t
+  GetEdgesBegin(uint32_t vertex) const;
+
+  uint32_t
+  GetEdgesEnd(uint32_t vertex) const;
+
+  uint32_t
+  GetTarget(uint32_t edge) const;
+
+  /**
+   * @brief Get metric of the edge (metric of the face, or zero for edges from channels)
+   */
+  uint32_t
+  GetWeight(uint32_t edge) const;
+
+  /**
+   * @brief Get face of the edge (nullptr for edges from channels)
+   */
+  const shared_ptr<Face>&
+  GetFace(uint32_t edge) const;
+
+  /**
+   * @brief Find edge from one vertex to another, or INVALID if vertices are not adjacent
+   */
+  uint32_t
+  FindEdge(uint32_t from, uint32_t to) const;
+
+  /**
+   * @brief Bring edge down (e.g., link failure) or up; edges that are down are ignored by all
+   *        shortest path calculations
+   *
+   * Cached distances are not updated.
+   */
+  void
+  SetEdgeUp(uint32_t edge, bool isUp);
+
+  bool
+  IsEdgeUp(uint32_t edge) const;
+
+  /**
+   * @brief Calculate shortest paths from @p source to all vertices (Dijkstra)
+   *
+   * Among equal-cost paths, the one with the lowest first hop is selected, i.e., the one via the
+   * face that was added to the source first.  The result does not depend on the order in which
+   * vertices are visited, so it is the same for any number of threads and after
+   * UpdateShortestPaths.
+   *
+   * Safe to call concurrently from multiple threads.
+   */
+  void
+  CalculateShortestPaths(uint32_t source, ShortestPaths& paths) const;
+
+  /**
+   * @brief Update shortest paths from @p source after @p edge went down or up
+   *
+   * When a tree edge goes down, only its subtree is recalculated, entering the subtree from the
+   * rest of the tree.  When an edge goes up, only vertices that become closer (or get a lower
+   * first hop at the same distance) are updated.  Paths are the same as those calculated by
+   * CalculateShortestPaths on the modified graph.
+   *
+   * Safe to call concurrently from multiple threads for different sources.
+   *
+   * @param[in,out] previous previous first hops and distances of the updated vertices (vertices
+   *                         already in the map are not overwritten)
+   */
+  void
+  UpdateShortestPaths(uint32_t source, uint32_t edge, ShortestPaths& paths,
+                      PreviousPaths& previous) const;
+
+  /**
+   * @brief Calculate and cache distances from each of @p sources to all vertices
+   *
+   * Distances are calculated in parallel, rows that are already cached are not recalculated.
+   * Route calculations that need distances from neighbors (e.g., LFID) derive them from the
+   * cached rows instead of running shortest path calculations on modified graphs.
+   *
+   * @param nThreads number of threads, 0 to use all hardware threads
+   */
+  void
+  CacheDistances(const std::vector<uint32_t>& sources, uint32_t nThreads);
+
+  /**
+   * @brief Get cached distances from @p source to all vertices
+   * @pre Distances from @p source have been calculated using CacheDistances
+   */
+  const std::vector<uint32_t>&
+  GetDistances(uint32_t source) const;
+
+  /**
+   * @brief Get distances from @p source that change when all edges from @p excluded are removed
+   *
+   * Derived from cached distances of @p source and @p excluded: only the vertices whose shortest
+   * paths all pass through @p excluded are recalculated.  This gives the distances from the
+   * neighbors of a node that do not go back through the node, without modifying face metrics.
+   *
+   * @param[out] changed new distances of the changed vertices (UNREACHABLE if not reachable
+   *                     anymore); distances to the other vertices are the same as cached
+   * @pre Distances from @p source and @p excluded have been calculated using CacheDistances
+   */
+  void
+  GetDistancesWithout(uint32_t source, uint32_t excluded,
+                      std::unordered_map<uint32_t, uint32_t>& changed) const;
+
+  /**
+   * @brief Run @p nJobs independent jobs on @p nThreads threads
+   *
+   * Jobs must not access ns-3 objects that are not thread-safe.
+   *
+   * @param nThreads number of threads, 0 to use all hardware threads
+   */
+  static void
+  RunParallel(size_t nJobs, uint32_t nThreads, const std::function<void(size_t)>& job);
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::unordered_map<uint32_t, uint32_t> m_vertices; ///< @brief GlobalRouter::GetId () => vertex
+
+  std::vector<uint32_t> m_offsets; ///< @brief first edge of every vertex, plus the end
+  std::vector<uint32_t> m_sources;
+  std::vector<uint32_t> m_targets;
+  std::vector<uint32_t> m_weights;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::vector<bool> m_isUp;
+
+  std::vector<uint32_t> m_inOffsets; ///< @brief first incoming edge of every vertex, plus the end
+  std::vector<uint32_t> m_inEdges;   ///< @brief edges grouped by their targets
+
+  std::vector<std::vector<uint32_t>> m_distances; ///< @brief cached rows, empty if not calculated
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
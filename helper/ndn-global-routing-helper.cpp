@@ -29,6 +29,8 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "helper/ndn-global-routing-graph.hpp"
+#include "utils/ndn-mem-accounting.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,23 +48,84 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
+#include <vector>
 
 #include <math.h>
 
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+uint32_t GlobalRoutingHelper::m_nThreads = 0;
+bool GlobalRoutingHelper::m_isIncremental = false;
+
+/**
+ * @brief Topology snapshot and shortest path trees of local nodes kept by CalculateRoutes for
+ *        incremental updates
+ */
+struct IncrementalRoutes {
+  GlobalRoutingGraph graph;
+  std::vector<uint32_t> sources;
+  std::vector<uint32_t> origins;
+  std::map<Name, std::vector<size_t>> prefixes; ///< @brief prefix => indices of its origins
+  std::vector<GlobalRoutingGraph::ShortestPaths> trees; ///< @brief for every source
+};
+
+static std::unique_ptr<IncrementalRoutes> g_incrementalRoutes;
+
+static void
+ClearIncrementalRoutes()
+{
+  g_incrementalRoutes.reset();
+}
+
+typedef std::pair<uint32_t, uint32_t> Route; // first edge, distance
+
+/**
+ * @brief Add route towards one of the origins of a prefix to the next hops of the prefix
+ *
+ * Several origins of the prefix can be reached via the same face, the shortest distance is kept.
+ * Routes to unreachable origins and via edges without faces are skipped.
+ */
+static void
+AddNextHop(const GlobalRoutingGraph& graph, const Route& route, std::vector<Route>& nextHops)
+{
+  if (route.first == GlobalRoutingGraph::INVALID || graph.GetFace(route.first) == nullptr)
+    return;
+
+  for (Route& nextHop : nextHops) {
+    if (nextHop.first == route.first) {
+      nextHop.second = std::min(nextHop.second, route.second);
+      return;
+    }
+  }
+  nextHops.push_back(route);
+}
+
+static const Route*
+FindNextHop(const std::vector<Route>& nextHops, uint32_t edge)
+{
+  for (const Route& nextHop : nextHops) {
+    if (nextHop.first == edge)
+      return &nextHop;
+  }
+  return nullptr;
+}
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -160,6 +223,17 @@ GlobalRoutingHelper::Install(Ptr<Channel> channel)
   }
 }
 
+bool
+GlobalRoutingHelper::IsLocal(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+  }
+#endif
+  return true;
+}
+
 void
 GlobalRoutingHelper::Install(const NodeContainer& nodes)
 {
@@ -215,173 +289,251 @@ GlobalRoutingHelper::AddOriginsForAll()
 }
 
 void
-GlobalRoutingHelper::CalculateRoutes()
+GlobalRoutingHelper::SetNThreads(uint32_t nThreads)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  m_nThreads = nThreads;
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+void
+GlobalRoutingHelper::SetIncremental(bool isIncremental)
+{
+  m_isIncremental = isIncremental;
+}
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+void
+GlobalRoutingHelper::CalculateRoutes()
+{
+  auto state = make_unique<IncrementalRoutes>();
+  GlobalRoutingGraph& graph = state->graph;
+
+  std::vector<uint32_t>& sources = state->sources;
+  std::vector<uint32_t>& origins = state->origins; // vertices with locally exported prefixes
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+    Ptr<GlobalRouter> gr = graph.GetRouter(vertex);
+    Ptr<Node> node = gr->GetObject<Node>();
+    if (node != 0 && IsLocal(node)) {
+      sources.push_back(vertex);
     }
+    if (!gr->GetLocalPrefixes().empty()) {
+      for (const auto& prefix : gr->GetLocalPrefixes()) {
+        state->prefixes[*prefix].push_back(origins.size());
+      }
+      origins.push_back(vertex);
+    }
+  }
 
-    boost::DistancesMap distances;
+  // Shortest path trees are calculated in batches: in parallel for all sources of the batch, then
+  // routes are installed sequentially, as FIBs are not thread-safe.  Only the first hops towards
+  // the origins are kept between the two steps, unless trees are kept for incremental updates.
+  const size_t batchSize = 1024;
+  std::vector<std::vector<Route>> routes;
+  std::vector<Route> nextHops;
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+  if (m_isIncremental) {
+    state->trees.resize(sources.size());
+  }
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  for (size_t batchStart = 0; batchStart < sources.size(); batchStart += batchSize) {
+    size_t batchEnd = std::min(sources.size(), batchStart + batchSize);
+    routes.resize(batchEnd - batchStart);
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+    GlobalRoutingGraph::RunParallel(batchEnd - batchStart, m_nThreads, [&](size_t i) {
+      GlobalRoutingGraph::ShortestPaths tree;
+      GlobalRoutingGraph::ShortestPaths& paths = m_isIncremental ? state->trees[batchStart + i]
+                                                                 : tree;
+      graph.CalculateShortestPaths(sources[batchStart + i], paths);
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
+      routes[i].clear();
+      for (uint32_t origin : origins) {
+        routes[i].push_back(Route(paths.firstHops[origin], paths.distances[origin]));
+      }
+    });
+
+    for (size_t i = 0; i < batchEnd - batchStart; i++) {
+      uint32_t source = sources[batchStart + i];
+      Ptr<Node> node = graph.GetRouter(source)->GetObject<Node>();
+      MemAccounting::Scope scope(MemAccounting::FIB, node->GetId());
+
+      NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+      for (const auto& prefix : state->prefixes) {
+        // a prefix with several origins gets one next hop per face, with the shortest distance
+        nextHops.clear();
+        for (size_t j : prefix.second) {
+          if (origins[j] != source)
+            AddNextHop(graph, routes[i][j], nextHops);
         }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
+
+        for (const Route& nextHop : nextHops) {
+          const shared_ptr<Face>& face = graph.GetFace(nextHop.first);
+          NS_LOG_DEBUG(" prefix " << prefix.first << " reachable via face " << *face
+                       << " with distance " << nextHop.second);
+
+          FibHelper::AddRoute(node, prefix.first, face, nextHop.second);
         }
       }
     }
   }
+
+  if (m_isIncremental) {
+    g_incrementalRoutes = std::move(state);
+    Simulator::ScheduleDestroy(&ClearIncrementalRoutes);
+  }
+  else {
+    ClearIncrementalRoutes();
+  }
 }
 
 void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+GlobalRoutingHelper::UpdateRoutes(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  if (g_incrementalRoutes == nullptr)
+    return;
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  IncrementalRoutes& state = *g_incrementalRoutes;
+  GlobalRoutingGraph& graph = state.graph;
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  Ptr<GlobalRouter> gr1 = node1->GetObject<GlobalRouter>();
+  Ptr<GlobalRouter> gr2 = node2->GetObject<GlobalRouter>();
+  if (gr1 == 0 || gr2 == 0)
+    return;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+  uint32_t vertex1 = graph.GetVertex(gr1);
+  uint32_t vertex2 = graph.GetVertex(gr2);
+  if (vertex1 == GlobalRoutingGraph::INVALID || vertex2 == GlobalRoutingGraph::INVALID)
+    return;
+
+  NS_LOG_DEBUG("Link " << node1->GetId() << " - " << node2->GetId() << " is "
+                       << (isUp ? "up" : "down"));
+
+  // Both directions of the link are updated one after another; previous first hops and distances
+  // are those before the first update, so routes are compared with the state before the change
+  std::vector<GlobalRoutingGraph::PreviousPaths> previous(state.sources.size());
+  for (uint32_t edge : {graph.FindEdge(vertex1, vertex2), graph.FindEdge(vertex2, vertex1)}) {
+    if (edge == GlobalRoutingGraph::INVALID || graph.IsEdgeUp(edge) == isUp)
       continue;
-    }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+    graph.SetEdgeUp(edge, isUp);
+    GlobalRoutingGraph::RunParallel(state.sources.size(), m_nThreads, [&](size_t i) {
+      graph.UpdateShortestPaths(state.sources[i], edge, state.trees[i], previous[i]);
+    });
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+  // Next hops are per prefix, not per origin: when a prefix has several origins, a face stays a
+  // next hop while it is on the shortest path to any of them, with the shortest of the distances
+  std::vector<Route> oldNextHops;
+  std::vector<Route> nextHops;
+  for (size_t i = 0; i < state.sources.size(); i++) {
+    if (previous[i].empty())
+      continue;
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+    uint32_t source = state.sources[i];
+    const GlobalRoutingGraph::ShortestPaths& tree = state.trees[i];
+    Ptr<Node> node = graph.GetRouter(source)->GetObject<Node>();
+    MemAccounting::Scope scope(MemAccounting::FIB, node->GetId());
+
+    for (const auto& prefix : state.prefixes) {
+      bool isChanged = false;
+      oldNextHops.clear();
+      nextHops.clear();
+      for (size_t j : prefix.second) {
+        uint32_t origin = state.origins[j];
+        if (origin == source)
+          continue;
+
+        Route route(tree.firstHops[origin], tree.distances[origin]);
+        auto old = previous[i].find(origin);
+        if (old != previous[i].end()) {
+          isChanged = true;
+          AddNextHop(graph, Route(old->second.first, old->second.second), oldNextHops);
+        }
+        else {
+          AddNextHop(graph, route, oldNextHops);
+        }
+        AddNextHop(graph, route, nextHops);
+      }
+      if (!isChanged)
+        continue;
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+      for (const Route& oldNextHop : oldNextHops) {
+        if (FindNextHop(nextHops, oldNextHop.first) == nullptr) {
+          NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix.first
+                       << " no longer reachable via face " << *graph.GetFace(oldNextHop.first));
+          FibHelper::RemoveRoute(node, prefix.first, graph.GetFace(oldNextHop.first));
+        }
+      }
+      for (const Route& nextHop : nextHops) {
+        const Route* oldNextHop = FindNextHop(oldNextHops, nextHop.first);
+        if (oldNextHop == nullptr || oldNextHop->second != nextHop.second) {
+          NS_LOG_DEBUG("Node " << node->GetId() << ": prefix " << prefix.first
+                       << " reachable via face " << *graph.GetFace(nextHop.first)
+                       << " with distance " << nextHop.second);
+          FibHelper::AddRoute(node, prefix.first, graph.GetFace(nextHop.first), nextHop.second);
+        }
+      }
     }
+  }
+}
 
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
-        continue;
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  GlobalRoutingGraph graph;
+
+  std::vector<uint32_t> sources;
+  std::vector<uint32_t> neighbors;
+  std::vector<uint32_t> origins;
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+    Ptr<GlobalRouter> gr = graph.GetRouter(vertex);
+    Ptr<Node> node = gr->GetObject<Node>();
+    if (node != 0 && IsLocal(node)) {
+      sources.push_back(vertex);
+      for (uint32_t edge = graph.GetEdgesBegin(vertex); edge < graph.GetEdgesEnd(vertex); edge++) {
+        neighbors.push_back(graph.GetTarget(edge));
       }
+    }
+    if (!gr->GetLocalPrefixes().empty()) {
+      origins.push_back(vertex);
+    }
+  }
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+  // Route via every face costs the metric of the face plus the distance from the neighbor on the
+  // other side that does not go back through the node.  These are derived from cached shortest
+  // path trees of the nodes and their neighbors, without disabling faces one by one.
+  neighbors.insert(neighbors.end(), sources.begin(), sources.end());
+  graph.CacheDistances(neighbors, m_nThreads);
 
-      boost::DistancesMap distances;
+  std::unordered_map<uint32_t, uint32_t> changed;
 
-      NS_LOG_DEBUG("-----------");
+  for (uint32_t source : sources) {
+    Ptr<Node> node = graph.GetRouter(source)->GetObject<Node>();
+    MemAccounting::Scope scope(MemAccounting::FIB, node->GetId());
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId() << " (" << Names::FindName(node)
+                                            << ")");
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    for (uint32_t edge = graph.GetEdgesBegin(source); edge < graph.GetEdgesEnd(source); edge++) {
+      const shared_ptr<Face>& face = graph.GetFace(edge);
+      const std::vector<uint32_t>& distances = graph.GetDistances(graph.GetTarget(edge));
+      graph.GetDistancesWithout(graph.GetTarget(edge), source, changed);
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
+      for (uint32_t origin : origins) {
+        if (origin == source)
           continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
-      }
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-    }
+        auto changedDistance = changed.find(origin);
+        uint32_t fromNeighbor =
+          changedDistance != changed.end() ? changedDistance->second : distances[origin];
+        if (fromNeighbor == GlobalRoutingGraph::UNREACHABLE)
+          continue;
+
+        uint32_t distance = graph.GetWeight(edge) + fromNeighbor;
+        for (const auto& prefix : graph.GetRouter(origin)->GetLocalPrefixes()) {
+          NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                       << " with distance " << distance);
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+          FibHelper::AddRoute(node, *prefix, face, distance);
+        }
+      }
     }
   }
 }
@@ -96,10 +96,49 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * In distributed (MPI) simulations, every rank keeps the complete topology graph, but calculates
+   * shortest path trees and installs FIB entries only for the nodes it simulates.
+   *
+   * Shortest path trees are calculated in parallel (see SetNThreads), FIB entries are installed
+   * sequentially afterwards.  Of several equal-cost paths, the one via the face that was created
+   * first on the node is used, independently of the number of threads.  A prefix with several
+   * origins gets a next hop via every face that leads to one of them, with the shortest distance.
    */
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Set number of threads used to calculate shortest path trees
+   * @param nThreads number of threads, 0 (default) to use all hardware threads
+   */
+  static void
+  SetNThreads(uint32_t nThreads);
+
+  /**
+   * @brief Enable or disable incremental update of routes installed by CalculateRoutes
+   *
+   * When enabled, CalculateRoutes keeps the topology snapshot and shortest path trees of all
+   * local nodes (memory is proportional to the number of nodes squared), which are then updated
+   * by UpdateRoutes on link failures and recoveries.  Must be set before CalculateRoutes.
+   */
+  static void
+  SetIncremental(bool isIncremental);
+
+  /**
+   * @brief Update routes after point-to-point link between two nodes went down or up
+   *
+   * Only destinations whose shortest paths go through the link (when it goes down) or become
+   * shorter through it (when it goes up) are recalculated, and only changed next hops are updated
+   * in FIBs: the stale next hop is removed and the new one is added.  A next hop of a prefix with
+   * several origins is removed only when it no longer leads to any of them.
+   *
+   * Called by LinkControlHelper::FailLink and LinkControlHelper::UpLink.  Does nothing, unless
+   * routes were calculated by CalculateRoutes with incremental updates enabled (SetIncremental).
+   */
+  static void
+  UpdateRoutes(Ptr<Node> node1, Ptr<Node> node2, bool isUp);
+
   /**
    * @brief Calculates a set of loop-free multipath routes.
    *
@@ -127,6 +166,16 @@ public:
 private:
   void
   Install(Ptr<Channel> channel);
+
+  /**
+   * @brief Check if the node is simulated by this MPI rank (always true if MPI is not enabled)
+   */
+  static bool
+  IsLocal(Ptr<Node> node);
+
+private:
+  static uint32_t m_nThreads;
+  static bool m_isIncremental;
 };
 
 } // namespace ndn
@@ -43,6 +43,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If routes were calculated with incremental updates enabled (see
+   * GlobalRoutingHelper::SetIncremental), routes affected by the link are updated as well
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -73,6 +76,9 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * If routes were calculated with incremental updates enabled (see
+   * GlobalRoutingHelper::SetIncremental), routes affected by the link are updated as well
+   *
    * @param node1 one node
    * @param node2 another node
    */
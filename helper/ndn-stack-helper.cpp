@@ -35,7 +35,18 @@
 #include "model/ndn-net-device-transport.hpp"
 #include "utils/ndn-time.hpp"
 #include "utils/dummy-keychain.hpp"
+#include "utils/ndn-mem-accounting.hpp"
 #include "model/cs/ndn-content-store.hpp"
+#include "model/cs/trie-policy-adapter.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/fifo-policy.hpp"
+#include "utils/trie/random-policy.hpp"
+#include "utils/trie/persistent-policy.hpp"
+#include "utils/trie/arc-policy.hpp"
+#include "utils/trie/two-queue-policy.hpp"
+#include "utils/trie/s3-fifo-policy.hpp"
+#include "utils/trie/tinylfu-policy.hpp"
 
 #include <limits>
 #include <map>
@@ -57,6 +68,15 @@ NS_LOG_COMPONENT_DEFINE("ndn.StackHelper");
 namespace ns3 {
 namespace ndn {
 
+template<class... PolicyTraits>
+static std::function<std::unique_ptr<nfd::cs::Policy>()>
+makeTriePolicyCreator(const std::string& policyName)
+{
+  return [policyName] {
+    return make_unique<cs::TriePolicy<boost::mpl::vector<PolicyTraits...>>>(policyName);
+  };
+}
+
 StackHelper::StackHelper()
   : m_isForwarderStatusManagerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
@@ -69,6 +89,27 @@ StackHelper::StackHelper()
   m_csPolicies.insert({"nfd::cs::lru", [] { return make_unique<nfd::cs::LruPolicy>(); }});
   m_csPolicies.insert({"nfd::cs::priority_fifo", [] () { return make_unique<nfd::cs::PriorityFifoPolicy>(); }});
 
+  // replacement policies from utils/trie on top of NFD's Content Store
+  m_csPolicies.insert({"ndnSIM::cs::lru",
+                       makeTriePolicyCreator<ndnSIM::lru_policy_traits>("ndnSIM::cs::lru")});
+  m_csPolicies.insert({"ndnSIM::cs::lfu",
+                       makeTriePolicyCreator<ndnSIM::lfu_policy_traits>("ndnSIM::cs::lfu")});
+  m_csPolicies.insert({"ndnSIM::cs::fifo",
+                       makeTriePolicyCreator<ndnSIM::fifo_policy_traits>("ndnSIM::cs::fifo")});
+  m_csPolicies.insert({"ndnSIM::cs::random",
+                       makeTriePolicyCreator<ndnSIM::random_policy_traits>("ndnSIM::cs::random")});
+  m_csPolicies.insert({"ndnSIM::cs::persistent",
+                       makeTriePolicyCreator<ndnSIM::persistent_policy_traits>("ndnSIM::cs::persistent")});
+  m_csPolicies.insert({"ndnSIM::cs::arc",
+                       makeTriePolicyCreator<ndnSIM::arc_policy_traits>("ndnSIM::cs::arc")});
+  m_csPolicies.insert({"ndnSIM::cs::2q",
+                       makeTriePolicyCreator<ndnSIM::two_queue_policy_traits>("ndnSIM::cs::2q")});
+  m_csPolicies.insert({"ndnSIM::cs::s3fifo",
+                       makeTriePolicyCreator<ndnSIM::s3_fifo_policy_traits>("ndnSIM::cs::s3fifo")});
+  m_csPolicies.insert({"ndnSIM::cs::lru-tinylfu",
+                       makeTriePolicyCreator<ndnSIM::lru_policy_traits,
+                                             ndnSIM::tinylfu_policy_traits>("ndnSIM::cs::lru-tinylfu")});
+
   m_csPolicyCreationFunc = m_csPolicies["nfd::cs::lru"];
 
   m_ndnFactory.SetTypeId("ns3::ndn::L3Protocol");
@@ -182,6 +223,17 @@ StackHelper::setPolicy(const std::string& policy)
   }
 }
 
+void
+StackHelper::setCsSnapshot(const std::string& file)
+{
+  if (file.empty()) {
+    m_csSnapshot = nullptr;
+  }
+  else {
+    m_csSnapshot = make_shared<CsSnapshotHelper::Snapshot>(CsSnapshotHelper::Read(file));
+  }
+}
+
 void
 StackHelper::Install(const NodeContainer& c) const
 {
@@ -245,6 +297,13 @@ StackHelper::doInstall(Ptr<Node> node) const
 
     this->createAndRegisterFace(node, ndn, device);
   }
+
+  if (m_csSnapshot != nullptr) {
+    auto content = m_csSnapshot->find(node->GetId());
+    if (content != m_csSnapshot->end()) {
+      CsSnapshotHelper::Preload(node, content->second);
+    }
+  }
 }
 
 void
@@ -509,6 +568,7 @@ StackHelper::UpdateAll()
 shared_ptr<Face>
 StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const
 {
+  MemAccounting::Scope scope(MemAccounting::FACE, node->GetId());
   shared_ptr<Face> face;
 
   for (const auto& item : m_netDeviceCallbacks) {
@@ -29,6 +29,7 @@
 
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
+#include "ndn-cs-snapshot-helper.hpp"
 
 namespace nfd {
 namespace cs {
@@ -98,6 +99,17 @@ public:
                   const std::string& value3 = "", const std::string& attr4 = "",
                   const std::string& value4 = "");
 
+  /**
+   * @brief Preload content stores from the snapshot file during stack installation
+   *
+   * Each node, on which the stack is installed, gets the content saved for the node with the
+   * same ID using CsSnapshotHelper::Save.  The file is read only once.
+   *
+   * @param file snapshot file, or empty string to disable preloading
+   */
+  void
+  setCsSnapshot(const std::string& file);
+
   typedef Callback<shared_ptr<Face>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice>>
     FaceCreateCallback;
 
@@ -300,6 +312,8 @@ private:
 
   std::map<std::string, PolicyCreationCallback> m_csPolicies;
 
+  shared_ptr<CsSnapshotHelper::Snapshot> m_csSnapshot;
+
   typedef std::list<std::pair<TypeId, FaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
 };
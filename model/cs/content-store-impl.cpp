@@ -23,8 +23,12 @@
 #include "../../utils/trie/lru-policy.hpp"
 #include "../../utils/trie/fifo-policy.hpp"
 #include "../../utils/trie/lfu-policy.hpp"
+#include "../../utils/trie/arc-policy.hpp"
+#include "../../utils/trie/two-queue-policy.hpp"
+#include "../../utils/trie/s3-fifo-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
+#include "../../utils/trie/tinylfu-policy.hpp"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -63,10 +67,28 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with Adaptive Replacement Cache (ARC) policy
+ **/
+template class ContentStoreImpl<arc_policy_traits>;
+
+/**
+ * @brief ContentStore with 2Q cache replacement policy
+ **/
+template class ContentStoreImpl<two_queue_policy_traits>;
+
+/**
+ * @brief ContentStore with S3-FIFO cache replacement policy
+ **/
+template class ContentStoreImpl<s3_fifo_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, two_queue_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, s3_fifo_policy_traits);
 
 typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, aggregate_stats_policy_traits>>
   LruWithCountsTraits;
@@ -90,6 +112,29 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+// TinyLFU admission filter must be the last policy, so it is consulted before the replacement
+// policy evicts anything
+typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, tinylfu_policy_traits>>
+  LruWithTinyLfuTraits;
+typedef multi_policy_traits<boost::mpl::vector2<random_policy_traits, tinylfu_policy_traits>>
+  RandomWithTinyLfuTraits;
+typedef multi_policy_traits<boost::mpl::vector2<fifo_policy_traits, tinylfu_policy_traits>>
+  FifoWithTinyLfuTraits;
+typedef multi_policy_traits<boost::mpl::vector2<lfu_policy_traits, tinylfu_policy_traits>>
+  LfuWithTinyLfuTraits;
+
+template class ContentStoreImpl<LruWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LruWithTinyLfuTraits);
+
+template class ContentStoreImpl<RandomWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RandomWithTinyLfuTraits);
+
+template class ContentStoreImpl<FifoWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithTinyLfuTraits);
+
+template class ContentStoreImpl<LfuWithTinyLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithTinyLfuTraits);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -114,6 +159,24 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store implementing Adaptive Replacement Cache (ARC) policy
+ */
+class Arc : public ContentStoreImpl<arc_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing 2Q cache replacement policy
+ */
+class TwoQ : public ContentStoreImpl<two_queue_policy_traits> {
+};
+
+/**
+ * \brief Content Store implementing S3-FIFO cache replacement policy
+ */
+class S3Fifo : public ContentStoreImpl<s3_fifo_policy_traits> {
+};
 #endif
 
 } // namespace cs
@@ -32,6 +32,8 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/ndn-forwarding-profiler.hpp"
+#include "../../utils/ndn-mem-accounting.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -97,7 +99,14 @@ public:
   static TypeId
   GetTypeId();
 
-  ContentStoreImpl(){};
+  ContentStoreImpl()
+  {
+    super::set_erase_callback([this](typename super::iterator item) {
+      if (!m_didRemoveEntry.IsEmpty())
+        m_didRemoveEntry(item->payload());
+    });
+  }
+
   virtual ~ContentStoreImpl(){};
 
   // from ContentStore
@@ -125,6 +134,12 @@ public:
 
   virtual Ptr<Entry> Next(Ptr<Entry>);
 
+  virtual std::vector<Ptr<Entry>>
+  GetEntriesInPolicyOrder();
+
+  virtual Ptr<Entry>
+  Evict();
+
   const typename super::policy_container&
   GetPolicy() const
   {
@@ -153,6 +168,10 @@ private:
   /// @brief trace of for entry additions (fired every time entry is successfully added to the
   /// cache): first parameter is pointer to the CS entry
   TracedCallback<Ptr<const Entry>> m_didAddEntry;
+
+  /// @brief trace of entry removals (fired every time entry is removed from the cache, except
+  /// when the whole cache is cleared): first parameter is pointer to the CS entry
+  TracedCallback<Ptr<const Entry>> m_didRemoveEntry;
 };
 
 //////////////////////////////////////////
@@ -180,6 +199,12 @@ ContentStoreImpl<Policy>::GetTypeId()
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
                       MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didAddEntry),
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback")
+
+      .AddTraceSource("DidRemoveEntry",
+                      "Trace fired every time entry is removed from the cache (evicted by the "
+                      "policy, expired, or erased explicitly)",
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didRemoveEntry),
                       "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback");
 
   return tid;
@@ -206,6 +231,7 @@ shared_ptr<Data>
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
+  ForwardingProfiler::Scope scope(ForwardingProfiler::CS_LOOKUP);
 
   typename super::const_iterator node;
   if (interest->getExclude().empty()) {
@@ -233,6 +259,8 @@ bool
 ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
 {
   NS_LOG_FUNCTION(this << data->getName());
+  ForwardingProfiler::Scope scope(ForwardingProfiler::CS_INSERT);
+  MemAccounting::Scope memScope(MemAccounting::CS);
 
   Ptr<entry> newEntry = Create<entry>(this, data);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
@@ -331,6 +359,35 @@ ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
     return item->payload();
 }
 
+template<class Policy>
+std::vector<Ptr<Entry>>
+ContentStoreImpl<Policy>::GetEntriesInPolicyOrder()
+{
+  std::vector<Ptr<Entry>> entries;
+  entries.reserve(this->getPolicy().size());
+
+  for (typename super::policy_container::iterator item = this->getPolicy().begin();
+       item != this->getPolicy().end(); item++) {
+    entries.push_back(item->payload());
+  }
+  return entries;
+}
+
+template<class Policy>
+Ptr<Entry>
+ContentStoreImpl<Policy>::Evict()
+{
+  if (this->getPolicy().size() == 0)
+    return 0;
+
+  typename super::iterator item = &(*this->getPolicy().begin());
+  Ptr<entry> evicted = item->payload();
+  NS_LOG_DEBUG("Evicting " << evicted->GetName());
+
+  super::erase(item);
+  return evicted;
+}
+
 } // namespace cs
 } // namespace ndn
 } // namespace ns3
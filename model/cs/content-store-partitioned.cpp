@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "content-store-partitioned.hpp"
+
+#include "utils/ndn-virtual-payload.hpp"
+
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.cs.Partitioned");
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+NS_OBJECT_ENSURE_REGISTERED(Partitioned);
+
+TypeId
+Partitioned::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::cs::Partitioned")
+      .SetGroupName("Ndn")
+      .SetParent<ContentStore>()
+      .AddConstructor<Partitioned>()
+
+      .AddAttribute("DefaultPolicy",
+                    "Content store type for Data not covered by any other partition",
+                    StringValue("ns3::ndn::cs::Lru"),
+                    MakeStringAccessor(&Partitioned::SetDefaultPolicy,
+                                       &Partitioned::GetDefaultPolicy),
+                    MakeStringChecker())
+
+      .AddAttribute("MaxSize",
+                    "Maximum number of entries in the default partition (0 for unlimited)",
+                    UintegerValue(100),
+                    MakeUintegerAccessor(&Partitioned::SetMaxSize, &Partitioned::GetMaxSize),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("PartitionCacheHits",
+                      "Trace called every time there is a cache hit, with the partition prefix",
+                      MakeTraceSourceAccessor(&Partitioned::m_partitionCacheHitsTrace),
+                      "ns3::ndn::cs::Partitioned::PartitionCacheHitsCallback")
+
+      .AddTraceSource("PartitionCacheMisses",
+                      "Trace called every time there is a cache miss, with the partition prefix",
+                      MakeTraceSourceAccessor(&Partitioned::m_partitionCacheMissesTrace),
+                      "ns3::ndn::cs::Partitioned::PartitionCacheMissesCallback");
+
+  return tid;
+}
+
+Partitioned::Partitioned()
+  : m_defaultPolicy("ns3::ndn::cs::Lru")
+{
+  m_partitions.push_back({Name("/"), CreateStore(m_defaultPolicy), 100, 0, false, 0});
+  m_partitionTable.insert(Name("/"), &m_partitions.front());
+}
+
+Partitioned::~Partitioned()
+{
+}
+
+Ptr<ContentStore>
+Partitioned::CreateStore(const std::string& policy)
+{
+  ObjectFactory factory;
+  factory.SetTypeId(policy);
+  Ptr<ContentStore> store = factory.Create<ContentStore>();
+
+  // capacity is enforced by the partition
+  store->SetAttributeFailSafe("MaxSize", UintegerValue(0));
+
+  // bytes are released whenever the store removes an entry, whatever the reason
+  if (!store->TraceConnectWithoutContext("DidRemoveEntry",
+                                         MakeCallback(&Partitioned::RemoveEntry, this))) {
+    NS_FATAL_ERROR("Content store " << policy << " cannot be used as a partition");
+  }
+  return store;
+}
+
+void
+Partitioned::RemoveEntry(Ptr<const Entry> entry)
+{
+  Ptr<ContentStore> store = ConstCast<Entry>(entry)->GetContentStore();
+  for (Partition& partition : m_partitions) {
+    if (partition.store == store) {
+      uint64_t size = GetEntrySize(*entry->GetData());
+      NS_ASSERT(partition.nBytes >= size);
+      partition.nBytes -= size;
+      return;
+    }
+  }
+}
+
+uint64_t
+Partitioned::GetEntrySize(const Data& data)
+{
+  return VirtualPayload::GetEncodedSize(data);
+}
+
+void
+Partitioned::AddPartition(const Name& prefix, const std::string& policy, uint32_t maxEntries,
+                          uint64_t maxBytes/* = 0*/, bool isPinned/* = false*/)
+{
+  if (prefix.empty()) {
+    NS_FATAL_ERROR("Use DefaultPolicy and MaxSize attributes to configure the default partition");
+  }
+  if (m_partitionTable.find_exact(prefix) != m_partitionTable.end()) {
+    NS_FATAL_ERROR("Partition for " << prefix << " already exists");
+  }
+
+  NS_LOG_DEBUG("Partition " << prefix << " (" << policy << ", maxEntries=" << maxEntries
+               << ", maxBytes=" << maxBytes << (isPinned ? ", pinned" : "") << ")");
+
+  m_partitions.push_back({prefix, CreateStore(policy), maxEntries, maxBytes, isPinned, 0});
+  m_partitionTable.insert(prefix, &m_partitions.back());
+}
+
+Ptr<ContentStore>
+Partitioned::GetPartitionStore(const Name& name) const
+{
+  return FindPartition(name).store;
+}
+
+Partitioned::Partition&
+Partitioned::FindPartition(const Name& name) const
+{
+  // the default partition is registered for the root, so there is always a match
+  PartitionTable::iterator node = m_partitionTable.longest_prefix_match(name);
+  return *node->payload();
+}
+
+bool
+Partitioned::HasRoom(const Partition& partition, uint64_t size) const
+{
+  return (partition.maxEntries == 0 || partition.store->GetSize() < partition.maxEntries)
+         && (partition.maxBytes == 0 || partition.nBytes + size <= partition.maxBytes);
+}
+
+bool
+Partitioned::IsOverLimit(const Partition& partition) const
+{
+  return (partition.maxEntries != 0 && partition.store->GetSize() > partition.maxEntries)
+         || (partition.maxBytes != 0 && partition.nBytes > partition.maxBytes);
+}
+
+shared_ptr<Data>
+Partitioned::Lookup(shared_ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION(this << interest->getName());
+
+  const Partition& partition = FindPartition(interest->getName());
+  shared_ptr<Data> data = partition.store->Lookup(interest);
+  if (data != nullptr) {
+    this->m_cacheHitsTrace(interest, data);
+    m_partitionCacheHitsTrace(partition.prefix, interest, data);
+  }
+  else {
+    this->m_cacheMissesTrace(interest);
+    m_partitionCacheMissesTrace(partition.prefix, interest);
+  }
+  return data;
+}
+
+bool
+Partitioned::Add(shared_ptr<const Data> data)
+{
+  NS_LOG_FUNCTION(this << data->getName());
+
+  Partition& partition = FindPartition(data->getName());
+  uint64_t size = GetEntrySize(*data);
+
+  if (partition.isPinned && !HasRoom(partition, size)) {
+    NS_LOG_DEBUG("Pinned partition " << partition.prefix << " is full, not caching");
+    return false;
+  }
+
+  // accounted before insertion, in case the store removes the new entry right away
+  partition.nBytes += size;
+  if (!partition.store->Add(data)) {
+    partition.nBytes -= size;
+    return false;
+  }
+
+  while (IsOverLimit(partition)) {
+    if (partition.store->Evict() == 0) {
+      NS_LOG_WARN("Content store of partition " << partition.prefix
+                  << " does not support eviction");
+      break;
+    }
+  }
+
+  return true;
+}
+
+void
+Partitioned::Print(std::ostream& os) const
+{
+  for (const Partition& partition : m_partitions) {
+    partition.store->Print(os);
+  }
+}
+
+uint32_t
+Partitioned::GetSize() const
+{
+  uint32_t size = 0;
+  for (const Partition& partition : m_partitions) {
+    size += partition.store->GetSize();
+  }
+  return size;
+}
+
+Ptr<Entry>
+Partitioned::Begin()
+{
+  for (const Partition& partition : m_partitions) {
+    Ptr<Entry> entry = partition.store->Begin();
+    if (entry != partition.store->End()) {
+      return entry;
+    }
+  }
+  return End();
+}
+
+Ptr<Entry>
+Partitioned::End()
+{
+  return 0;
+}
+
+Ptr<Entry>
+Partitioned::Next(Ptr<Entry> from)
+{
+  if (from == 0)
+    return End();
+
+  auto partition = m_partitions.begin();
+  while (partition != m_partitions.end() && partition->store != from->GetContentStore()) {
+    ++partition;
+  }
+  if (partition == m_partitions.end())
+    return End();
+
+  Ptr<Entry> entry = partition->store->Next(from);
+  if (entry != partition->store->End())
+    return entry;
+
+  for (++partition; partition != m_partitions.end(); ++partition) {
+    entry = partition->store->Begin();
+    if (entry != partition->store->End()) {
+      return entry;
+    }
+  }
+  return End();
+}
+
+std::vector<Ptr<Entry>>
+Partitioned::GetEntriesInPolicyOrder()
+{
+  std::vector<Ptr<Entry>> entries;
+  for (const Partition& partition : m_partitions) {
+    std::vector<Ptr<Entry>> partitionEntries = partition.store->GetEntriesInPolicyOrder();
+    entries.insert(entries.end(), partitionEntries.begin(), partitionEntries.end());
+  }
+  return entries;
+}
+
+void
+Partitioned::SetDefaultPolicy(const std::string& policy)
+{
+  Partition& defaultPartition = m_partitions.front();
+  if (defaultPartition.store->GetSize() > 0) {
+    NS_FATAL_ERROR("Cannot change policy of a non-empty default partition");
+  }
+
+  m_defaultPolicy = policy;
+  defaultPartition.store = CreateStore(policy);
+}
+
+std::string
+Partitioned::GetDefaultPolicy() const
+{
+  return m_defaultPolicy;
+}
+
+void
+Partitioned::SetMaxSize(uint32_t maxSize)
+{
+  m_partitions.front().maxEntries = maxSize;
+}
+
+uint32_t
+Partitioned::GetMaxSize() const
+{
+  return m_partitions.front().maxEntries;
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
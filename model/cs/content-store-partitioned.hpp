@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#ifndef NDN_CONTENT_STORE_PARTITIONED_H
+#define NDN_CONTENT_STORE_PARTITIONED_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+
+#include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/empty-policy.hpp"
+
+#include "ns3/traced-callback.h"
+
+#include <list>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store split by name prefix into partitions
+ *
+ * Every partition has its own content store (and thus its own replacement policy) and its own
+ * capacity, in number of entries and/or in bytes of Data wire encoding (including the emulated
+ * virtual payload).  Data and Interests are
+ * routed to the partition with the longest prefix matching their name; names not covered by any
+ * partition go to the default partition (configured with DefaultPolicy and MaxSize attributes).
+ *
+ * Entries of a pinned partition are never evicted: when a pinned partition is full, new Data is
+ * simply not cached.  This allows, for example, reserving space for safety-related namespaces
+ * that would otherwise be flushed by bulk traffic.
+ *
+ * Partitions are added with AddPartition() after the content store is installed on the node:
+ *
+ *     Ptr<cs::Partitioned> cs = DynamicCast<cs::Partitioned>(node->GetObject<ContentStore>());
+ *     cs->AddPartition("/safety", "ns3::ndn::cs::Lru", 50, 0, true);
+ *     cs->AddPartition("/infotainment", "ns3::ndn::cs::Lru", 0, 1024 * 1024);
+ */
+class Partitioned : public ContentStore {
+public:
+  static TypeId
+  GetTypeId();
+
+  Partitioned();
+
+  virtual ~Partitioned();
+
+  /**
+   * @brief Add partition for the namespace
+   * @param prefix      namespace of the partition
+   * @param policy      TypeId of the content store for the partition (e.g., "ns3::ndn::cs::Lru")
+   * @param maxEntries  maximum number of entries in the partition (0 for unlimited)
+   * @param maxBytes    maximum total size of Data in the partition (0 for unlimited)
+   * @param isPinned    if true, entries are never evicted and new Data is not cached when full
+   */
+  void
+  AddPartition(const Name& prefix, const std::string& policy, uint32_t maxEntries,
+               uint64_t maxBytes = 0, bool isPinned = false);
+
+  /**
+   * @brief Get content store of the partition that handles the name
+   */
+  Ptr<ContentStore>
+  GetPartitionStore(const Name& name) const;
+
+  // from ContentStore
+
+  virtual shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual bool
+  Add(shared_ptr<const Data> data);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+  virtual uint32_t
+  GetSize() const;
+
+  virtual Ptr<Entry>
+  Begin();
+
+  virtual Ptr<Entry>
+  End();
+
+  virtual Ptr<Entry> Next(Ptr<Entry>);
+
+  virtual std::vector<Ptr<Entry>>
+  GetEntriesInPolicyOrder();
+
+public:
+  typedef void (*PartitionCacheHitsCallback)(const Name&, shared_ptr<const Interest>,
+                                             shared_ptr<const Data>);
+  typedef void (*PartitionCacheMissesCallback)(const Name&, shared_ptr<const Interest>);
+
+private:
+  struct Partition {
+    Name prefix;
+    Ptr<ContentStore> store;
+    uint32_t maxEntries;
+    uint64_t maxBytes;
+    bool isPinned;
+    uint64_t nBytes; ///< @brief size of entries in the store, updated on every removal
+  };
+
+  Partition&
+  FindPartition(const Name& name) const;
+
+  bool
+  HasRoom(const Partition& partition, uint64_t size) const;
+
+  bool
+  IsOverLimit(const Partition& partition) const;
+
+  Ptr<ContentStore>
+  CreateStore(const std::string& policy);
+
+  void
+  RemoveEntry(Ptr<const Entry> entry);
+
+  /**
+   * @brief Get size of Data accounted against the byte limit of the partition
+   *
+   * Size of the wire encoding, including the emulated virtual payload (see VirtualPayload)
+   */
+  static uint64_t
+  GetEntrySize(const Data& data);
+
+  void
+  SetDefaultPolicy(const std::string& policy);
+
+  std::string
+  GetDefaultPolicy() const;
+
+  void
+  SetMaxSize(uint32_t maxSize);
+
+  uint32_t
+  GetMaxSize() const;
+
+private:
+  std::list<Partition> m_partitions; ///< @brief all partitions, the default one first
+
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::pointer_payload_traits<Partition>,
+                                   ndnSIM::empty_policy_traits> PartitionTable;
+  mutable PartitionTable m_partitionTable;
+
+  std::string m_defaultPolicy;
+
+  TracedCallback<const Name&, shared_ptr<const Interest>, shared_ptr<const Data>>
+    m_partitionCacheHitsTrace;
+  TracedCallback<const Name&, shared_ptr<const Interest>> m_partitionCacheMissesTrace;
+};
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_PARTITIONED_H
@@ -24,7 +24,10 @@
 
 #include "content-store-impl.hpp"
 
+#include "ns3/nstime.h"
+
 #include "../../utils/trie/multi-policy.hpp"
+#include "../../utils/ndn-event-accounting.hpp"
 #include "custom-policies/freshness-policy.hpp"
 
 namespace ns3 {
@@ -34,6 +37,13 @@ namespace cs {
 /**
  * @ingroup ndn-cs
  * @brief Special content store realization that honors Freshness parameter in Data packets
+ *
+ * Staleness is checked lazily: every lookup first drops entries that have already expired, so a
+ * stale Data is never returned.  In addition, a coarse periodic sweeper (see CleaningInterval
+ * attribute) evicts expired entries in batches, so that the scheduler sees at most one cleaning
+ * event per interval, independent of the insertion rate.  With zero CleaningInterval, the sweeper
+ * is rescheduled whenever a new entry expires before the pending wake up, so every entry is
+ * removed exactly when it becomes stale.
  */
 template<class Policy>
 class ContentStoreWithFreshness
@@ -55,21 +65,35 @@ public:
   virtual inline void
   Print(std::ostream& os) const;
 
+  virtual inline shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
   virtual inline bool
   Add(shared_ptr<const Data> data);
 
+protected:
+  virtual void
+  DoDispose();
+
 private:
+  /**
+   * @brief Remove all entries that are already stale
+   * @returns number of removed entries
+   */
+  inline size_t
+  RemoveExpired();
+
   inline void
   CleanExpired();
 
   inline void
-  RescheduleCleaning();
+  ScheduleCleaning();
 
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   EventId m_cleanEvent;
-  Time m_scheduledCleaningTime;
+  Time m_cleaningInterval;
 };
 
 //////////////////////////////////////////
@@ -89,12 +113,29 @@ ContentStoreWithFreshness<Policy>::GetTypeId()
                         .SetParent<super>()
                         .template AddConstructor<ContentStoreWithFreshness<Policy>>()
 
+                        .AddAttribute("CleaningInterval",
+                                      "Granularity of the periodic sweep of expired entries. "
+                                      "Stale entries are never returned by lookups, this only "
+                                      "limits how long they can occupy the cache",
+                                      TimeValue(Seconds(1)),
+                                      MakeTimeAccessor(
+                                        &ContentStoreWithFreshness<Policy>::m_cleaningInterval),
+                                      MakeTimeChecker(Time(0)))
+
     // trace stuff here
     ;
 
   return tid;
 }
 
+template<class Policy>
+inline shared_ptr<Data>
+ContentStoreWithFreshness<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  RemoveExpired();
+  return super::Lookup(interest);
+}
+
 template<class Policy>
 inline bool
 ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data)
@@ -104,51 +145,59 @@ ContentStoreWithFreshness<Policy>::Add(shared_ptr<const Data> data)
     return false;
 
   NS_LOG_DEBUG(data->getName() << " added to cache");
-  RescheduleCleaning();
+  ScheduleCleaning();
   return true;
 }
 
+template<class Policy>
+void
+ContentStoreWithFreshness<Policy>::DoDispose()
+{
+  m_cleanEvent.Cancel();
+  super::DoDispose();
+}
+
 template<class Policy>
 inline void
-ContentStoreWithFreshness<Policy>::RescheduleCleaning()
+ContentStoreWithFreshness<Policy>::ScheduleCleaning()
 {
+  if (m_cleanEvent.IsRunning() && !m_cleaningInterval.IsZero())
+    return; // sweeper is already active, it will pick up the new entry
+
   const freshness_policy_container& freshness =
     this->getPolicy().template get<freshness_policy_container>();
 
   if (freshness.size() > 0) {
-    Time nextStateTime =
+    Time nextStaleTime =
       freshness_policy_container::policy_base::get_freshness(&(*freshness.begin()));
 
-    if (m_scheduledCleaningTime.IsZero() ||      // if not yet scheduled
-        m_scheduledCleaningTime > nextStateTime) // if new item expire sooner than already scheduled
-    {
+    Time delay = m_cleaningInterval;
+    if (delay.IsZero()) { // zero granularity: wake up exactly when the earliest entry expires
+      delay = nextStaleTime > Now() ? nextStaleTime - Now() : Time(0);
+
       if (m_cleanEvent.IsRunning()) {
-        Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
-      }
+        if (Simulator::GetDelayLeft(m_cleanEvent) <= delay)
+          return; // pending wake up is early enough
 
-      // NS_LOG_DEBUG ("Next event in: " << (nextStateTime - Now ()).ToDouble (Time::S) << "s");
-      m_cleanEvent = Simulator::Schedule(nextStateTime - Now(),
-                                         &ContentStoreWithFreshness<Policy>::CleanExpired, this);
-      m_scheduledCleaningTime = nextStateTime;
-    }
-  }
-  else {
-    if (m_cleanEvent.IsRunning()) {
-      Simulator::Remove(m_cleanEvent); // just canceling would not clean up list of events
+        m_cleanEvent.Cancel();
+      }
     }
+
+    m_cleanEvent = EventAccounting::Schedule(EventAccounting::CS_CLEANING, delay,
+                                             &ContentStoreWithFreshness<Policy>::CleanExpired,
+                                             this);
   }
 }
 
 template<class Policy>
-inline void
-ContentStoreWithFreshness<Policy>::CleanExpired()
+inline size_t
+ContentStoreWithFreshness<Policy>::RemoveExpired()
 {
   freshness_policy_container& freshness =
     this->getPolicy().template get<freshness_policy_container>();
 
-  // NS_LOG_LOGIC (">> Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
-  // with freshness: " << freshness.size ());
   Time now = Simulator::Now();
+  size_t removed = 0;
 
   while (!freshness.empty()) {
     typename freshness_policy_container::iterator entry = freshness.begin();
@@ -157,15 +206,24 @@ ContentStoreWithFreshness<Policy>::CleanExpired()
         <= now) // is the record stale?
     {
       super::erase(&(*entry));
+      ++removed;
     }
     else
       break; // nothing else to do. All later records will not be stale
   }
-  // NS_LOG_LOGIC ("<< Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
-  // with freshness: " << freshness.size ());
 
-  m_scheduledCleaningTime = Time();
-  RescheduleCleaning();
+  return removed;
+}
+
+template<class Policy>
+inline void
+ContentStoreWithFreshness<Policy>::CleanExpired()
+{
+  size_t removed = RemoveExpired();
+  NS_LOG_LOGIC("Removed " << removed << " stale entries, " << this->getPolicy().size()
+                          << " entries left");
+
+  ScheduleCleaning();
 }
 
 template<class Policy>
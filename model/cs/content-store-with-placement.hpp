@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#ifndef NDN_CONTENT_STORE_WITH_PLACEMENT_H_
+#define NDN_CONTENT_STORE_WITH_PLACEMENT_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "content-store-impl.hpp"
+
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/type-id.h"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <iterator>
+#include <list>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Path-aware decision on where Data is cached
+ */
+enum PlacementStrategy {
+  ALWAYS,          ///< cache every Data (same as the plain replacement policy)
+  PROB_CACHE,      ///< ProbCache: favour nodes that leave more cache space towards consumers
+  LEAVE_COPY_DOWN, ///< cache only one hop downstream of the node that satisfied the Interest
+  BETWEENNESS      ///< admit with probability equal to the node's normalized betweenness
+};
+
+/**
+ * @ingroup ndn-cs
+ * @brief Content store realization that decides whether to cache Data based on the position
+ *        of the node on the delivery path (placement policy)
+ *
+ * The position is derived from lp::HopCountTag: the hop count of the Data is the distance to
+ * the node that satisfied the Interest (producer or cache), while the hop count of the Interest,
+ * remembered on a cache miss, is the distance to the consumer.  Their sum is the path length.
+ *
+ * On a cache hit the hop count of the returned Data is reset to zero, so downstream nodes see
+ * the distance to this cache rather than to the original producer.
+ */
+template<class Policy>
+class ContentStoreWithPlacement : public ContentStoreImpl<Policy> {
+public:
+  typedef ContentStoreImpl<Policy> super;
+
+  static TypeId
+  GetTypeId();
+
+  ContentStoreWithPlacement();
+
+  virtual inline shared_ptr<Data>
+  Lookup(shared_ptr<const Interest> interest);
+
+  virtual inline bool
+  Add(shared_ptr<const Data> data);
+
+  /**
+   * @brief Get probability with which @p data is admitted into this content store
+   *
+   * The Interest for the Data, if it was seen by the content store, defines the path length.
+   */
+  double
+  GetAdmissionProbability(const Data& data) const;
+
+public:
+  typedef void (*RejectDataCallback)(shared_ptr<const Data>);
+
+private:
+  void
+  RememberInterest(const Name& name, uint64_t hopCount);
+
+  template<class Packet>
+  static uint64_t
+  GetHopCount(const Packet& packet)
+  {
+    shared_ptr<lp::HopCountTag> tag = packet.template getTag<lp::HopCountTag>();
+    return tag == nullptr ? 0 : tag->get();
+  }
+
+private:
+  static LogComponent g_log; ///< @brief Logging variable
+
+  PlacementStrategy m_strategy;
+  double m_timesIn;
+  double m_betweenness;
+  uint32_t m_pendingLimit;
+  Ptr<UniformRandomVariable> m_rand;
+
+  /// @brief hop counts of Interests that missed the cache, bounded by m_pendingLimit (FIFO)
+  std::map<Name, std::pair<uint64_t, std::list<Name>::iterator>> m_pending;
+  std::list<Name> m_pendingOrder;
+
+  /// @brief trace fired every time Data is not admitted into the cache by placement decision
+  TracedCallback<shared_ptr<const Data>> m_didRejectData;
+};
+
+//////////////////////////////////////////
+////////// Implementation ////////////////
+//////////////////////////////////////////
+
+template<class Policy>
+LogComponent ContentStoreWithPlacement<Policy>::g_log = LogComponent(("ndn.cs.Placement."
+                                                                      + Policy::GetName()).c_str(),
+                                                                     __FILE__);
+
+template<class Policy>
+TypeId
+ContentStoreWithPlacement<Policy>::GetTypeId()
+{
+  static TypeId tid =
+    TypeId(("ns3::ndn::cs::Placement::" + Policy::GetName()).c_str())
+      .SetGroupName("Ndn")
+      .SetParent<super>()
+      .template AddConstructor<ContentStoreWithPlacement<Policy>>()
+
+      .AddAttribute("Strategy",
+                    "Placement strategy (Always, ProbCache, Lcd, or Betweenness)",
+                    EnumValue(PROB_CACHE),
+                    MakeEnumAccessor(&ContentStoreWithPlacement<Policy>::m_strategy),
+                    MakeEnumChecker(ALWAYS, "Always", PROB_CACHE, "ProbCache",
+                                    LEAVE_COPY_DOWN, "Lcd", BETWEENNESS, "Betweenness"))
+
+      .AddAttribute("TimesIn",
+                    "ProbCache target time window, expressed in number of cache sizes "
+                    "that the path should be able to hold",
+                    DoubleValue(10.0),
+                    MakeDoubleAccessor(&ContentStoreWithPlacement<Policy>::m_timesIn),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("Betweenness",
+                    "Normalized betweenness centrality of the node, used by Betweenness "
+                    "strategy (see CachePlacementHelper::InstallBetweenness)",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&ContentStoreWithPlacement<Policy>::m_betweenness),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("PendingLimit",
+                    "Maximum number of Interest hop counts remembered until Data arrives",
+                    UintegerValue(1000),
+                    MakeUintegerAccessor(&ContentStoreWithPlacement<Policy>::m_pendingLimit),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddTraceSource("DidRejectData",
+                      "Trace fired every time Data is not admitted by the placement strategy",
+                      MakeTraceSourceAccessor(&ContentStoreWithPlacement<Policy>::m_didRejectData),
+                      "ns3::ndn::cs::ContentStoreWithPlacement::RejectDataCallback");
+
+  return tid;
+}
+
+template<class Policy>
+ContentStoreWithPlacement<Policy>::ContentStoreWithPlacement()
+  : m_strategy(PROB_CACHE)
+  , m_timesIn(10.0)
+  , m_betweenness(1.0)
+  , m_pendingLimit(1000)
+  , m_rand(CreateObject<UniformRandomVariable>())
+{
+}
+
+template<class Policy>
+shared_ptr<Data>
+ContentStoreWithPlacement<Policy>::Lookup(shared_ptr<const Interest> interest)
+{
+  shared_ptr<Data> data = super::Lookup(interest);
+  if (data != nullptr) {
+    data->setTag(make_shared<lp::HopCountTag>(0));
+  }
+  else {
+    RememberInterest(interest->getName(), GetHopCount(*interest));
+  }
+  return data;
+}
+
+template<class Policy>
+bool
+ContentStoreWithPlacement<Policy>::Add(shared_ptr<const Data> data)
+{
+  double probability = GetAdmissionProbability(*data);
+
+  auto pending = m_pending.find(data->getName());
+  if (pending != m_pending.end()) {
+    m_pendingOrder.erase(pending->second.second);
+    m_pending.erase(pending);
+  }
+
+  if (probability <= 0.0 || (probability < 1.0 && m_rand->GetValue() >= probability)) {
+    NS_LOG_DEBUG("Not caching " << data->getName() << " (p = " << probability << ")");
+    m_didRejectData(data);
+    return false;
+  }
+
+  return super::Add(data);
+}
+
+template<class Policy>
+double
+ContentStoreWithPlacement<Policy>::GetAdmissionProbability(const Data& data) const
+{
+  uint64_t fromSource = GetHopCount(data);
+
+  switch (m_strategy) {
+  case ALWAYS:
+    return 1.0;
+
+  case LEAVE_COPY_DOWN:
+    return fromSource == 1 ? 1.0 : 0.0;
+
+  case BETWEENNESS:
+    return fromSource == 0 ? 0.0 : m_betweenness;
+
+  case PROB_CACHE: {
+    if (fromSource == 0) // this node is the source, nothing to save upstream
+      return 0.0;
+
+    auto pending = m_pending.find(data.getName());
+    uint64_t toConsumer = pending != m_pending.end() ? pending->second.first : 0;
+    double pathLength = fromSource + toConsumer;
+
+    // TimesIn (with equally sized caches): how many caches remain towards the consumer,
+    // relative to the target window; CacheWeight: how far the node is from the source
+    double timesIn = (pathLength - fromSource + 1) / m_timesIn;
+    double cacheWeight = fromSource / pathLength;
+    return std::min(1.0, timesIn * cacheWeight);
+  }
+  }
+
+  return 1.0;
+}
+
+template<class Policy>
+void
+ContentStoreWithPlacement<Policy>::RememberInterest(const Name& name, uint64_t hopCount)
+{
+  auto pending = m_pending.find(name);
+  if (pending != m_pending.end()) {
+    pending->second.first = hopCount;
+    return;
+  }
+
+  while (!m_pending.empty() && m_pending.size() >= m_pendingLimit) {
+    m_pending.erase(m_pendingOrder.front());
+    m_pendingOrder.pop_front();
+  }
+
+  m_pendingOrder.push_back(name);
+  m_pending.emplace(name, std::make_pair(hopCount, std::prev(m_pendingOrder.end())));
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_WITH_PLACEMENT_H_
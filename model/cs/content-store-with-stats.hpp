@@ -25,8 +25,12 @@
 #include "content-store-impl.hpp"
 
 #include "../../utils/trie/multi-policy.hpp"
+#include "../../utils/ndn-event-accounting.hpp"
 #include "custom-policies/lifetime-stats-policy.hpp"
 
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
 namespace ns3 {
 namespace ndn {
 namespace cs {
@@ -63,15 +67,62 @@ public:
   virtual inline void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Aggregate lifetimes and reuse distances of entries under @p prefix separately
+   *
+   * Histograms are kept for the longest matching prefix; entries that do not match any of the
+   * added prefixes are aggregated under "/".
+   */
+  void
+  AddHistogramPrefix(const Name& prefix)
+  {
+    this->getPolicy().template get<1>().add_histogram_prefix(prefix);
+  }
+
+  /**
+   * @brief Get lifetime and reuse distance histograms since the last interval, by prefix
+   */
+  const std::map<Name, ndnSIM::lifetime_histograms>&
+  GetHistograms() const
+  {
+    return this->getPolicy().template get<1>().get_all_histograms();
+  }
+
 public:
   typedef void (*RemoveCsEntryCallback)(Ptr<const Entry>, Time);
 
+  typedef void (*HistogramsCallback)(const Name&, const LogHistogram&, const LogHistogram&);
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  void
+  SetHistogramInterval(Time interval);
+
+  Time
+  GetHistogramInterval() const
+  {
+    return m_histogramInterval;
+  }
+
+  void
+  EmitHistograms();
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   /// @brief trace of for entry removal: first parameter is pointer to the CS entry, second is how
   /// long entry was in the cache
   TracedCallback<Ptr<const Entry>, Time> m_willRemoveEntry;
+
+  /// @brief trace fired once per HistogramInterval for every histogram prefix: prefix,
+  /// lifetime histogram (microseconds), and reuse distance histogram
+  TracedCallback<const Name&, const LogHistogram&, const LogHistogram&> m_histograms;
+
+  Time m_histogramInterval;
+  EventId m_histogramEvent;
 };
 
 //////////////////////////////////////////
@@ -92,11 +143,24 @@ ContentStoreWithStats<Policy>::GetTypeId()
       .SetParent<super>()
       .template AddConstructor<ContentStoreWithStats<Policy>>()
 
+      .AddAttribute("HistogramInterval",
+                    "If not zero, lifetimes and reuse distances of entries are aggregated into "
+                    "histograms, which are reported via LifetimeHistograms trace once per interval",
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&ContentStoreWithStats<Policy>::SetHistogramInterval,
+                                     &ContentStoreWithStats<Policy>::GetHistogramInterval),
+                    MakeTimeChecker())
+
       .AddTraceSource("WillRemoveEntry",
                       "Trace called just before content store entry will be removed",
                       MakeTraceSourceAccessor(&ContentStoreWithStats<Policy>::m_willRemoveEntry),
                       "ns3::ndn::cs::ContentStoreWithStats::RemoveCsEntryCallback")
 
+      .AddTraceSource("LifetimeHistograms",
+                      "Trace called once per HistogramInterval for each histogram prefix",
+                      MakeTraceSourceAccessor(&ContentStoreWithStats<Policy>::m_histograms),
+                      "ns3::ndn::cs::ContentStoreWithStats::HistogramsCallback")
+
     // trace stuff here
     ;
 
@@ -117,6 +181,44 @@ ContentStoreWithStats<Policy>::Print(std::ostream& os) const
   }
 }
 
+template<class Policy>
+void
+ContentStoreWithStats<Policy>::SetHistogramInterval(Time interval)
+{
+  m_histogramInterval = interval;
+  m_histogramEvent.Cancel();
+
+  this->getPolicy().template get<1>().set_aggregate(!interval.IsZero());
+  this->getPolicy().template get<1>().reset_histograms();
+  if (!interval.IsZero()) {
+    m_histogramEvent = EventAccounting::Schedule(EventAccounting::CS_STATS, interval,
+                                                 &ContentStoreWithStats<Policy>::EmitHistograms,
+                                                 this);
+  }
+}
+
+template<class Policy>
+void
+ContentStoreWithStats<Policy>::EmitHistograms()
+{
+  for (const auto& histograms : GetHistograms()) {
+    m_histograms(histograms.first, histograms.second.lifetime, histograms.second.reuseDistance);
+  }
+  this->getPolicy().template get<1>().reset_histograms();
+
+  m_histogramEvent = EventAccounting::Schedule(EventAccounting::CS_STATS, m_histogramInterval,
+                                               &ContentStoreWithStats<Policy>::EmitHistograms,
+                                               this);
+}
+
+template<class Policy>
+void
+ContentStoreWithStats<Policy>::DoDispose()
+{
+  m_histogramEvent.Cancel();
+  super::DoDispose();
+}
+
 } // namespace cs
 } // namespace ndn
 } // namespace ns3
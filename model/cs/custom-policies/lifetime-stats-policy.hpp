@@ -23,6 +23,7 @@
 /// @cond include_hidden
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-log-histogram.hpp"
 
 #include <boost/intrusive/options.hpp>
 #include <boost/intrusive/list.hpp>
@@ -31,12 +32,28 @@
 #include <ns3/simulator.h>
 #include <ns3/traced-callback.h>
 
+#include <map>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
+/**
+ * @brief Lifetime and reuse distance histograms of CS entries under a prefix
+ *
+ * Lifetime is counted in microseconds.  Reuse distance of a cache hit is the number of
+ * cache operations (insertions and hits) since the previous access to the same entry.
+ */
+struct lifetime_histograms {
+  LogHistogram lifetime;
+  LogHistogram reuseDistance;
+};
+
 /**
  * @brief Traits for lifetime stats policy
+ *
+ * On entry removal the policy either fires the per-entry traced callback (only if something is
+ * connected to it) or, if aggregation is enabled, adds the lifetime to per-prefix histograms.
  */
 struct lifetime_stats_policy_traits {
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
@@ -48,6 +65,7 @@ struct lifetime_stats_policy_traits {
 
   struct policy_hook_type : public boost::intrusive::list_member_hook<> {
     Time timeWhenAdded;
+    uint64_t lastAccess;
   };
 
   template<class Container>
@@ -74,6 +92,13 @@ struct lifetime_stats_policy_traits {
                policy_container::value_traits::to_node_ptr(*item))->timeWhenAdded;
     }
 
+    static uint64_t&
+    get_last_access(typename Container::iterator item)
+    {
+      return static_cast<typename policy_container::value_traits::hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item))->lastAccess;
+    }
+
     class type : public policy_container {
     public:
       typedef policy policy_base; // to get access to get_time methods from outside
@@ -83,7 +108,10 @@ struct lifetime_stats_policy_traits {
         : base_(base)
         , max_size_(100)
         , m_willRemoveEntry(0)
+        , aggregate_(false)
+        , accesses_(0)
       {
+        histograms_[Name("/")];
       }
 
       inline void
@@ -96,6 +124,7 @@ struct lifetime_stats_policy_traits {
       insert(typename parent_trie::iterator item)
       {
         get_time(item) = Simulator::Now();
+        get_last_access(item) = accesses_++;
 
         policy_container::push_back(*item);
         return true;
@@ -104,16 +133,23 @@ struct lifetime_stats_policy_traits {
       inline void
       lookup(typename parent_trie::iterator item)
       {
-        // do nothing. it's random policy
+        uint64_t& lastAccess = get_last_access(item);
+        if (aggregate_) {
+          get_histograms(item).reuseDistance.Add(accesses_ - lastAccess - 1);
+        }
+        lastAccess = accesses_++;
       }
 
       inline void
       erase(typename parent_trie::iterator item)
       {
-        Time lifetime = Simulator::Now() - get_time(item);
+        if (aggregate_) {
+          Time lifetime = Simulator::Now() - get_time(item);
+          get_histograms(item).lifetime.Add(lifetime.GetMicroSeconds());
+        }
 
-        if (m_willRemoveEntry != 0) {
-          (*m_willRemoveEntry)(item->payload(), lifetime);
+        if (m_willRemoveEntry != 0 && !m_willRemoveEntry->IsEmpty()) {
+          (*m_willRemoveEntry)(item->payload(), Simulator::Now() - get_time(item));
         }
 
         policy_container::erase(policy_container::s_iterator_to(*item));
@@ -144,6 +180,60 @@ struct lifetime_stats_policy_traits {
         m_willRemoveEntry = callback;
       }
 
+      /**
+       * @brief Enable or disable aggregation of lifetimes and reuse distances into histograms
+       */
+      void
+      set_aggregate(bool aggregate)
+      {
+        aggregate_ = aggregate;
+      }
+
+      bool
+      get_aggregate() const
+      {
+        return aggregate_;
+      }
+
+      /**
+       * @brief Keep separate histograms for entries under @p prefix (longest prefix wins)
+       */
+      void
+      add_histogram_prefix(const Name& prefix)
+      {
+        histograms_[prefix];
+      }
+
+      const std::map<Name, lifetime_histograms>&
+      get_all_histograms() const
+      {
+        return histograms_;
+      }
+
+      void
+      reset_histograms()
+      {
+        for (auto& histograms : histograms_) {
+          histograms.second.lifetime.Reset();
+          histograms.second.reuseDistance.Reset();
+        }
+      }
+
+    private:
+      lifetime_histograms&
+      get_histograms(typename parent_trie::iterator item)
+      {
+        if (histograms_.size() == 1)
+          return histograms_.begin()->second;
+
+        const Name& name = item->payload()->GetName();
+        for (auto prefix = histograms_.rbegin(); prefix != histograms_.rend(); ++prefix) {
+          if (prefix->first.isPrefixOf(name))
+            return prefix->second;
+        }
+        return histograms_.begin()->second;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -154,6 +244,10 @@ struct lifetime_stats_policy_traits {
 
       TracedCallback<typename parent_trie::payload_traits::const_base_type, Time>*
         m_willRemoveEntry;
+
+      bool aggregate_;
+      uint64_t accesses_;
+      std::map<Name, lifetime_histograms> histograms_;
     };
   };
 };
@@ -52,6 +52,22 @@ ContentStore::~ContentStore()
 {
 }
 
+std::vector<Ptr<cs::Entry>>
+ContentStore::GetEntriesInPolicyOrder()
+{
+  std::vector<Ptr<cs::Entry>> entries;
+  for (Ptr<cs::Entry> entry = Begin(); entry != End(); entry = Next(entry)) {
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+Ptr<cs::Entry>
+ContentStore::Evict()
+{
+  return 0;
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@
 #include "ns3/traced-callback.h"
 
 #include <tuple>
+#include <vector>
 
 namespace ns3 {
 
@@ -168,6 +169,26 @@ public:
    */
   virtual Ptr<cs::Entry> Next(Ptr<cs::Entry>) = 0;
 
+  /**
+   * @brief Get all entries in the order of the replacement policy (first to be evicted first)
+   *
+   * Re-adding the returned entries in the same order to an empty content store restores the
+   * state of the replacement policy as closely as possible.  Default implementation returns
+   * entries in Begin()/Next() order.
+   */
+  virtual std::vector<Ptr<cs::Entry>>
+  GetEntriesInPolicyOrder();
+
+  /**
+   * @brief Remove one entry, chosen by the replacement policy
+   *
+   * Default implementation does not support eviction and returns 0.
+   *
+   * @returns removed entry or 0 if nothing has been removed
+   */
+  virtual Ptr<cs::Entry>
+  Evict();
+
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_MODEL_CS_TRIE_POLICY_ADAPTER_HPP
+#define NDNSIM_MODEL_CS_TRIE_POLICY_ADAPTER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/cs-policy.hpp"
+
+#include "ndn-content-store.hpp"
+
+#include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/multi-policy.hpp"
+
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for a bogus policy that reports every entry removed from the trie
+ *
+ * Used by cs::TriePolicy to learn which entries were evicted by the replacement policy.
+ */
+struct erase_observer_policy_traits {
+  static std::string
+  GetName()
+  {
+    return "EraseObserver";
+  }
+
+  struct policy_hook_type {
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef policy_hook_type type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    class type {
+    public:
+      typedef Container parent_trie;
+      typedef std::function<void(typename parent_trie::iterator)> callback_type;
+
+      type(Base& base)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        if (on_erase_) {
+          on_erase_(item);
+        }
+      }
+
+      inline void
+      clear()
+      {
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return 0;
+      }
+
+      void
+      set_callback(const callback_type& callback)
+      {
+        on_erase_ = callback;
+      }
+
+    private:
+      callback_type on_erase_;
+    };
+  };
+};
+
+} // namespace ndnSIM
+
+namespace cs {
+
+/**
+ * @ingroup ndn-cs
+ * @brief Adapter that makes replacement policies from utils/trie usable as NFD's CS policy
+ *
+ * NFD's Content Store keeps the Data packets and handles lookups, while the policy traits (e.g.,
+ * lfu_policy_traits, arc_policy_traits, or lru_policy_traits followed by tinylfu_policy_traits)
+ * decide which entries are evicted or not admitted at all.  Entries are tracked in a trie indexed
+ * by the full name of Data.
+ *
+ * @tparam Policies boost::mpl vector of policy traits, combined the same way as for
+ *                  ndnSIM::multi_policy_traits (the first one defines the eviction order)
+ */
+template<class Policies>
+class TriePolicy : public nfd::cs::Policy {
+public:
+  explicit TriePolicy(const std::string& policyName)
+    : nfd::cs::Policy(policyName)
+    , m_isErasing(false)
+  {
+    m_trie.getPolicy().template get<boost::mpl::size<Policies>::value>().set_callback(
+      [this](typename Trie::iterator item) {
+        if (!m_isErasing) {
+          m_evicted.push_back(*item->payload());
+        }
+      });
+  }
+
+private:
+  void
+  doAfterInsert(EntryRef i) override
+  {
+    // if the entry is not admitted, it is reported by the observer and evicted below
+    m_trie.insert(i->getFullName(), i);
+    this->evictEntries();
+  }
+
+  void
+  doAfterRefresh(EntryRef i) override
+  {
+    typename Trie::iterator item = m_trie.find_exact(i->getFullName());
+    if (item != m_trie.end()) {
+      m_trie.getPolicy().update(item);
+    }
+  }
+
+  void
+  doBeforeErase(EntryRef i) override
+  {
+    typename Trie::iterator item = m_trie.find_exact(i->getFullName());
+    if (item != m_trie.end()) {
+      m_isErasing = true;
+      m_trie.erase(item);
+      m_isErasing = false;
+    }
+  }
+
+  void
+  doBeforeUse(EntryRef i) override
+  {
+    typename Trie::iterator item = m_trie.find_exact(i->getFullName());
+    if (item != m_trie.end()) {
+      m_trie.getPolicy().lookup(item);
+    }
+  }
+
+  void
+  evictEntries() override
+  {
+    if (m_trie.getPolicy().get_max_size() != this->getLimit()) {
+      m_trie.getPolicy().set_max_size(this->getLimit());
+    }
+
+    while (m_trie.getPolicy().size() > this->getLimit()) {
+      m_trie.erase(&(*m_trie.getPolicy().begin()));
+    }
+
+    std::vector<EntryRef> evicted;
+    evicted.swap(m_evicted);
+    for (const EntryRef& entry : evicted) {
+      this->emitSignal(beforeEvict, entry);
+    }
+  }
+
+private:
+  typedef ndnSIM::multi_policy_traits<
+    typename boost::mpl::push_back<Policies, ndnSIM::erase_observer_policy_traits>::type>
+    PolicyTraits;
+
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<boost::optional<EntryRef>>,
+                                   PolicyTraits> Trie;
+
+  Trie m_trie;
+  std::vector<EntryRef> m_evicted; ///< @brief entries removed by the policy, not yet reported to CS
+  bool m_isErasing;                ///< @brief true while the CS itself erases an entry
+};
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_MODEL_CS_TRIE_POLICY_ADAPTER_HPP
@@ -26,6 +26,7 @@
 #include "ns3/simulator.h"
 
 #include "apps/ndn-app.hpp"
+#include "utils/ndn-event-accounting.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppLinkService");
 
@@ -52,7 +53,8 @@ AppLinkService::doSendInterest(const Interest& interest)
   NS_LOG_FUNCTION(this << &interest);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  EventAccounting::ScheduleNow(EventAccounting::APP_DELIVERY, &App::OnInterest, m_app,
+                               interest.shared_from_this());
 }
 
 void
@@ -61,7 +63,8 @@ AppLinkService::doSendData(const Data& data)
   NS_LOG_FUNCTION(this << &data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  EventAccounting::ScheduleNow(EventAccounting::APP_DELIVERY, &App::OnData, m_app,
+                               data.shared_from_this());
 }
 
 void
@@ -70,7 +73,8 @@ AppLinkService::doSendNack(const lp::Nack& nack)
   NS_LOG_FUNCTION(this << &nack);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnNack, m_app, make_shared<lp::Nack>(nack));
+  EventAccounting::ScheduleNow(EventAccounting::APP_DELIVERY, &App::OnNack, m_app,
+                               make_shared<lp::Nack>(nack));
 }
 
 //
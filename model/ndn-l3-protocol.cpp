@@ -32,6 +32,8 @@
 #include "ndn-net-device-transport.hpp"
 
 #include "../helper/ndn-stack-helper.hpp"
+#include "../utils/ndn-forwarding-profiler.hpp"
+#include "../utils/ndn-mem-accounting.hpp"
 #include "cs/ndn-content-store.hpp"
 
 #include <boost/property_tree/info_parser.hpp>
@@ -403,51 +405,91 @@ L3Protocol::addFace(shared_ptr<Face> face)
 {
   NS_LOG_FUNCTION(this << face.get());
 
+  // forwarder pipelines are connected to the face signals by addFace, slots connected before and
+  // after them bracket the pipelines
+  bool isBracketed = ForwardingProfiler::IsEnabled() || MemAccounting::IsEnabled();
+  uint32_t nodeId = m_node->GetId();
+  if (isBracketed) {
+    face->afterReceiveInterest.connect([nodeId](const Interest&) {
+        ForwardingProfiler::Enter(nodeId, ForwardingProfiler::INCOMING_INTEREST);
+        MemAccounting::Enter(MemAccounting::PIT, nodeId);
+      });
+    face->afterReceiveData.connect([nodeId](const Data&) {
+        ForwardingProfiler::Enter(nodeId, ForwardingProfiler::INCOMING_DATA);
+        MemAccounting::Enter(MemAccounting::CS, nodeId);
+      });
+    face->afterReceiveNack.connect([nodeId](const lp::Nack&) {
+        ForwardingProfiler::Enter(nodeId, ForwardingProfiler::INCOMING_NACK);
+        MemAccounting::Enter(MemAccounting::PIT, nodeId);
+      });
+  }
+
   m_impl->m_forwarder->addFace(face);
 
+  if (isBracketed) {
+    face->afterReceiveInterest.connect([](const Interest&) {
+        MemAccounting::Leave();
+        ForwardingProfiler::Leave(ForwardingProfiler::INCOMING_INTEREST);
+      });
+    face->afterReceiveData.connect([](const Data&) {
+        MemAccounting::Leave();
+        ForwardingProfiler::Leave(ForwardingProfiler::INCOMING_DATA);
+      });
+    face->afterReceiveNack.connect([](const lp::Nack&) {
+        MemAccounting::Leave();
+        ForwardingProfiler::Leave(ForwardingProfiler::INCOMING_NACK);
+      });
+  }
+
   std::weak_ptr<Face> weakFace = face;
 
   // // Connect Signals to TraceSource
-  face->afterReceiveInterest.connect([this, weakFace](const Interest& interest) {
+  face->afterReceiveInterest.connect([this, weakFace, nodeId](const Interest& interest) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_inInterests(interest, *face);
       }
     });
 
-  face->afterReceiveData.connect([this, weakFace](const Data& data) {
+  face->afterReceiveData.connect([this, weakFace, nodeId](const Data& data) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_inData(data, *face);
       }
     });
 
-  face->afterReceiveNack.connect([this, weakFace](const lp::Nack& nack) {
+  face->afterReceiveNack.connect([this, weakFace, nodeId](const lp::Nack& nack) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_inNack(nack, *face);
       }
     });
 
   auto tracingLink = face->getLinkService();
   NS_LOG_LOGIC("Adding trace sources for afterSendInterest and afterSendData");
-  tracingLink->afterSendInterest.connect([this, weakFace](const Interest& interest) {
+  tracingLink->afterSendInterest.connect([this, weakFace, nodeId](const Interest& interest) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_outInterests(interest, *face);
       }
     });
 
-  tracingLink->afterSendData.connect([this, weakFace](const Data& data) {
+  tracingLink->afterSendData.connect([this, weakFace, nodeId](const Data& data) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_outData(data, *face);
       }
     });
 
-  tracingLink->afterSendNack.connect([this, weakFace](const lp::Nack& nack) {
+  tracingLink->afterSendNack.connect([this, weakFace, nodeId](const lp::Nack& nack) {
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
+        ForwardingProfiler::Scope scope(nodeId, ForwardingProfiler::TRACE);
         this->m_outNack(nack, *face);
       }
     });
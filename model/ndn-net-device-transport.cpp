@@ -22,6 +22,9 @@
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
+#include "../utils/ndn-virtual-payload.hpp"
+#include "../utils/ndn-forwarding-profiler.hpp"
+#include "../utils/ndn-mem-accounting.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -36,6 +39,12 @@ NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Approximate size of NDNLP fields added to each fragment (LpPacket and Fragment
+ *        headers, Sequence, FragIndex, and FragCount)
+ */
+static const uint32_t LP_FRAGMENT_OVERHEAD = 24;
+
 NetDeviceTransport::NetDeviceTransport(Ptr<Node> node,
                                        const Ptr<NetDevice>& netDevice,
                                        const std::string& localUri,
@@ -113,15 +122,21 @@ NetDeviceTransport::doSend(Packet&& packet)
   NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                   << this->getLocalUri());
 
-  // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
+  ForwardingProfiler::Scope scope(m_node->GetId(), ForwardingProfiler::SEND);
+  MemAccounting::Scope memScope(MemAccounting::FACE, m_node->GetId());
 
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+  // convert NFD packet to NS3 packet(s) and send them
+  std::vector<Ptr<ns3::Packet>> ns3Packets;
+  {
+    ForwardingProfiler::Scope encode(ForwardingProfiler::ENCODE);
+    ns3Packets = toNs3Packets(packet);
+  }
+  countPadding(packet, ns3Packets);
 
-  // send the NS3 packet
-  m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  for (const auto& ns3Packet : ns3Packets) {
+    m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
+                      L3Protocol::ETHERNET_FRAME_TYPE);
+  }
 }
 
 ////////////////////////////////
@@ -131,11 +146,9 @@ NetDeviceTransport::doSendX(Packet&& packet)
 {
   NS_LOG_FUNCTION(this << "Sending Interest on CCH from netDevice with URI"
                   << this->getLocalUri());
-   // convert NFD packet to NS3 packet
-  BlockHeader header(packet);
-
-  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-  ns3Packet->AddHeader(header);
+   // convert NFD packet to NS3 packet(s)
+  std::vector<Ptr<ns3::Packet>> ns3Packets = toNs3Packets(packet);
+  countPadding(packet, ns3Packets);
 
   //NS_LOG_DEBUG("Type = " << m_netDevice->GetTypeId().GetName());
 
@@ -143,18 +156,71 @@ NetDeviceTransport::doSendX(Packet&& packet)
   
   const Ptr<WaveNetDevice> waveNet = DynamicCast<WaveNetDevice> (m_netDevice);
     
-  if (waveNet != nullptr) { // WAVE
-    waveNet->SendX  (ns3Packet, m_netDevice->GetBroadcast(),
-                            L3Protocol::ETHERNET_FRAME_TYPE, txInfo);    
-  }
-  else { // Not WAVE
-    m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
-                    L3Protocol::ETHERNET_FRAME_TYPE);
+  for (const auto& ns3Packet : ns3Packets) {
+    if (waveNet != nullptr) { // WAVE
+      waveNet->SendX  (ns3Packet, m_netDevice->GetBroadcast(),
+                              L3Protocol::ETHERNET_FRAME_TYPE, txInfo);
+    }
+    else { // Not WAVE
+      m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
+                      L3Protocol::ETHERNET_FRAME_TYPE);
+    }
   }
 
 }
 ////////////////////////////////
 
+std::vector<Ptr<ns3::Packet>>
+NetDeviceTransport::toNs3Packets(const Packet& packet) const
+{
+  BlockHeader header(packet);
+  uint32_t padding = VirtualPayload::GetPadding(packet.packet);
+  uint32_t headerSize = header.GetSerializedSize();
+  uint32_t mtu = m_netDevice->GetMtu();
+
+  std::vector<Ptr<ns3::Packet>> ns3Packets;
+  if (padding == 0 || headerSize + padding <= mtu || mtu <= headerSize + LP_FRAGMENT_OVERHEAD) {
+    Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(padding);
+    ns3Packet->AddHeader(header);
+    ns3Packets.push_back(ns3Packet);
+    return ns3Packets;
+  }
+
+  // emulate NDNLP fragmentation: padding-only fragments (starting with zero byte, which is not a
+  // valid TLV type) go first, the last one carries the packet itself
+  uint32_t total = headerSize + padding;
+  uint32_t fragmentPayload = mtu - LP_FRAGMENT_OVERHEAD;
+  uint32_t nFragments = (total + fragmentPayload - 1) / fragmentPayload;
+  uint32_t lastSize = total + nFragments * LP_FRAGMENT_OVERHEAD - (nFragments - 1) * mtu;
+  uint32_t deficit = lastSize < headerSize ? headerSize - lastSize : 0;
+
+  for (uint32_t i = 0; i + 1 < nFragments; i++) {
+    ns3Packets.push_back(Create<ns3::Packet>(i == 0 ? mtu - deficit : mtu));
+  }
+
+  Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>(lastSize + deficit - headerSize);
+  ns3Packet->AddHeader(header);
+  ns3Packets.push_back(ns3Packet);
+
+  NS_LOG_DEBUG("Data with virtual payload sent as " << nFragments << " fragments");
+  return ns3Packets;
+}
+
+void
+NetDeviceTransport::countPadding(const Packet& packet,
+                                 const std::vector<Ptr<ns3::Packet>>& ns3Packets)
+{
+  // Transport::send has counted the wire encoding; add padding and emulated NDNLP overhead, so
+  // that face byte counters match the real payload
+  uint64_t nBytes = 0;
+  for (const auto& ns3Packet : ns3Packets) {
+    nBytes += ns3Packet->GetSize();
+  }
+  if (nBytes > packet.packet.size()) {
+    this->nOutBytes += nBytes - packet.packet.size();
+  }
+}
+
 // callback
 void
 NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
@@ -165,11 +231,27 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
+  ForwardingProfiler::Scope scope(m_node->GetId(), ForwardingProfiler::RECEIVE);
+  MemAccounting::Scope memScope(MemAccounting::FACE, m_node->GetId());
+
   // Convert NS3 packet to NFD packet
-  Ptr<ns3::Packet> packet = p->Copy();
+  uint8_t type = 0;
+  if (p->CopyData(&type, 1) == 0 || type == 0) {
+    // padding-only fragment of Data with virtual payload
+    this->nInBytes += p->GetSize();
+    return;
+  }
 
   BlockHeader header;
-  packet->RemoveHeader(header);
+  {
+    ForwardingProfiler::Scope decode(ForwardingProfiler::DECODE);
+    Ptr<ns3::Packet> packet = p->Copy();
+    packet->RemoveHeader(header);
+
+    // whatever follows the header is padding of virtual payload, which Transport::receive does
+    // not see
+    this->nInBytes += packet->GetSize();
+  }
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
 
@@ -32,6 +32,8 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -70,6 +72,23 @@ private:
   doSendX(Packet&& packet) override;
   ////////////////////////////////
 
+  /**
+   * @brief Convert NFD packet to ns-3 packets
+   *
+   * Usually there is one packet.  If the packet carries Data with virtual payload, it is padded
+   * to the size with the real payload and, if that exceeds MTU, preceded by padding-only
+   * packets that stand for the NDNLP fragments the real Data would be split into.
+   */
+  std::vector<Ptr<ns3::Packet>>
+  toNs3Packets(const Packet& packet) const;
+
+  /**
+   * @brief Add bytes that ns-3 packets carry beyond the wire encoding of @p packet (padding of
+   *        virtual payload and emulated NDNLP fragments) to the face byte counters
+   */
+  void
+  countPadding(const Packet& packet, const std::vector<Ptr<ns3::Packet>>& ns3Packets);
+
   void
   receiveFromNetDevice(Ptr<NetDevice> device,
                        Ptr<const ns3::Packet> p,
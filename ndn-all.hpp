@@ -24,6 +24,8 @@
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-network-region-table-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-cs-snapshot-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-cache-placement-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-ip-faces-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 
@@ -31,9 +33,15 @@
 #include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
 #include "ns3/ndnSIM/utils/topology/rocketfuel-weights-reader.hpp"
 #include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-reader.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/ndn-event-accounting.hpp"
+#include "ns3/ndnSIM/utils/ndn-forwarding-profiler.hpp"
+#include "ns3/ndnSIM/utils/ndn-mem-accounting.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
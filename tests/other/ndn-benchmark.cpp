@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ndn-benchmark/benchmark.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+
+namespace ns3 {
+
+/**
+ * Microbenchmarks of ndnSIM hot paths (defined in ndn-benchmark directory):
+ *
+ *     ./waf --run "ndn-benchmark --filter=Trie/.* --out=current.json"
+ *     ./waf --run "ndn-benchmark --out=current.json --baseline=baseline.json"
+ *
+ * Results are written in JSON format of Google Benchmark.  With --baseline, real time of every
+ * benchmark is compared with the baseline and the program fails if any benchmark is slower than
+ * the baseline by more than --threshold.
+ */
+int
+main(int argc, char* argv[])
+{
+  std::string filter = ".*";
+  std::string out;
+  std::string baselineFile;
+  double threshold = 0.1;
+  double minTime = 0.5;
+  int nRepetitions = 3;
+  bool shouldList = false;
+
+  CommandLine cmd;
+  cmd.AddValue("filter", "Regular expression selecting benchmarks to run", filter);
+  cmd.AddValue("out", "File to write JSON results to (- for standard output)", out);
+  cmd.AddValue("baseline", "JSON results to compare with", baselineFile);
+  cmd.AddValue("threshold", "Relative slowdown reported as regression", threshold);
+  cmd.AddValue("min-time", "Minimum time (seconds) of each measurement", minTime);
+  cmd.AddValue("repetitions", "Number of measurements, the median is reported", nRepetitions);
+  cmd.AddValue("list", "List benchmarks without running them", shouldList);
+  cmd.Parse(argc, argv);
+
+  std::vector<ndn::benchmark::Result> baseline;
+  if (!baselineFile.empty()) {
+    std::ifstream is(baselineFile.c_str());
+    if (!is.is_open()) {
+      std::cerr << "File " << baselineFile << " cannot be opened for reading" << std::endl;
+      return 2;
+    }
+    baseline = ndn::benchmark::ReadJson(is);
+  }
+
+  // progress goes to stderr if JSON is written to the standard output
+  std::ostream& log = out == "-" ? std::cerr : std::cout;
+
+  std::regex selected(filter);
+  std::vector<ndn::benchmark::Result> results;
+  for (const auto& benchmark : ndn::benchmark::GetBenchmarks()) {
+    if (!std::regex_search(benchmark.name, selected))
+      continue;
+
+    if (shouldList) {
+      log << benchmark.name << "\n";
+      continue;
+    }
+
+    results.push_back(ndn::benchmark::Run(benchmark, minTime, std::max(nRepetitions, 1)));
+
+    const auto& result = results.back();
+    log << std::left << std::setw(50) << result.name << std::right << std::fixed
+        << std::setprecision(1) << std::setw(15) << result.realTime << " ns" << std::setw(15)
+        << result.cpuTime << " ns" << std::setw(12) << result.nIterations;
+    if (result.itemsPerSecond > 0) {
+      log << std::setw(15) << std::setprecision(0) << result.itemsPerSecond << " items/s";
+    }
+    log << std::defaultfloat << std::endl;
+  }
+
+  if (!out.empty()) {
+    if (out == "-") {
+      ndn::benchmark::WriteJson(std::cout, results);
+    }
+    else {
+      std::ofstream os(out.c_str());
+      if (!os.is_open()) {
+        std::cerr << "File " << out << " cannot be opened for writing" << std::endl;
+        return 2;
+      }
+      ndn::benchmark::WriteJson(os, results);
+    }
+  }
+
+  if (!baselineFile.empty()) {
+    log << "\n";
+    size_t nRegressions = ndn::benchmark::Compare(log, results, baseline, threshold);
+    if (nRegressions > 0) {
+      log << nRegressions << " benchmark(s) regressed by more than " << 100 * threshold << "%"
+          << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
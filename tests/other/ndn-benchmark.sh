@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# Run microbenchmarks of ndnSIM hot paths and compare them with the stored baseline
+#
+#     ./ndn-benchmark.sh            # compare with the baseline (if stored)
+#     ./ndn-benchmark.sh --update   # store results as the new baseline
+#
+# Additional options (e.g., --filter=Trie/.*) are passed to the benchmark program
+
+baseline=ndn-benchmark-baseline.json
+current=ndn-benchmark-current.json
+
+update=0
+args=""
+for arg in "$@"; do
+    if [ "$arg" = "--update" ]; then
+        update=1
+    else
+        args="$args $arg"
+    fi
+done
+
+if [ $update -eq 0 ] && [ -f "$baseline" ]; then
+    args="$args --baseline=$(pwd)/$baseline"
+fi
+
+../../../waf --run ndn-benchmark --command-template="%s --out=$(pwd)/$current $args"
+status=$?
+
+if [ $update -eq 1 ] && [ $status -eq 0 ]; then
+    mv "$current" "$baseline"
+fi
+
+exit $status
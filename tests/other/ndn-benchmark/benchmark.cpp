@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <thread>
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+State::State(uint64_t nIterations)
+  : m_nIterations(nIterations)
+  , m_iteration(0)
+  , m_nItems(0)
+  , m_isRunning(false)
+  , m_cpuStart(0)
+  , m_realTime(0)
+  , m_cpuTime(0)
+{
+}
+
+void
+State::PauseTiming()
+{
+  if (!m_isRunning)
+    return;
+
+  m_realTime += std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                              - m_realStart).count();
+  m_cpuTime += static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+  m_isRunning = false;
+}
+
+void
+State::ResumeTiming()
+{
+  if (m_isRunning)
+    return;
+
+  m_isRunning = true;
+  m_cpuStart = std::clock();
+  m_realStart = std::chrono::steady_clock::now();
+}
+
+std::vector<Benchmark>&
+GetBenchmarks()
+{
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+Registrar::Registrar(const std::string& name, const Function& function)
+{
+  GetBenchmarks().push_back({name, function});
+}
+
+static void
+Cleanup()
+{
+  Simulator::Destroy();
+  Names::Clear();
+  GlobalRouter::clear();
+}
+
+static Result
+MakeResult(const Benchmark& benchmark, const State& state)
+{
+  double nIterations = static_cast<double>(state.GetIterations());
+  Result result = {benchmark.name, state.GetIterations(), 1e9 * state.GetRealTime() / nIterations,
+                   1e9 * state.GetCpuTime() / nIterations, 0};
+  if (state.GetItemsProcessed() > 0 && state.GetRealTime() > 0) {
+    result.itemsPerSecond = state.GetItemsProcessed() / state.GetRealTime();
+  }
+  return result;
+}
+
+Result
+Run(const Benchmark& benchmark, double minTime, int nRepetitions)
+{
+  const uint64_t maxIterations = 1000000000;
+
+  std::vector<Result> results;
+  uint64_t nIterations = 1;
+  while (true) {
+    State state(nIterations);
+    benchmark.function(state);
+    Cleanup();
+
+    if (state.GetRealTime() >= minTime || nIterations >= maxIterations) {
+      results.push_back(MakeResult(benchmark, state));
+      break;
+    }
+
+    // aim a bit above the minimum time, but do not trust very short measurements too much
+    double multiplier = 10.0;
+    if (state.GetRealTime() > 0.1 * minTime) {
+      multiplier = std::min(multiplier, 1.4 * minTime / state.GetRealTime());
+    }
+    nIterations = std::min(maxIterations,
+                           std::max(nIterations + 1,
+                                    static_cast<uint64_t>(nIterations * multiplier)));
+  }
+
+  // further repetitions use the calibrated number of iterations
+  for (int repetition = 1; repetition < nRepetitions; repetition++) {
+    State state(nIterations);
+    benchmark.function(state);
+    Cleanup();
+    results.push_back(MakeResult(benchmark, state));
+  }
+
+  auto median = results.begin() + results.size() / 2;
+  std::nth_element(results.begin(), median, results.end(), [] (const Result& a, const Result& b) {
+      return a.realTime < b.realTime;
+    });
+  return *median;
+}
+
+static std::string
+Quote(const std::string& value)
+{
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+void
+WriteJson(std::ostream& os, const std::vector<Result>& results)
+{
+  std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+#if defined(NS3_BUILD_PROFILE_DEBUG)
+  const char* buildType = "debug";
+#elif defined(NS3_BUILD_PROFILE_OPTIMIZED)
+  const char* buildType = "optimized";
+#else
+  const char* buildType = "release";
+#endif
+
+  os << "{\n"
+     << "  \"context\": {\n"
+     << "    \"date\": " << Quote(date) << ",\n"
+     << "    \"executable\": \"ndn-benchmark\",\n"
+     << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+     << "    \"library_build_type\": " << Quote(buildType) << "\n"
+     << "  },\n"
+     << "  \"benchmarks\": [";
+
+  os << std::setprecision(10);
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\n"
+       << "      \"name\": " << Quote(result.name) << ",\n"
+       << "      \"run_type\": \"iteration\",\n"
+       << "      \"iterations\": " << result.nIterations << ",\n"
+       << "      \"real_time\": " << result.realTime << ",\n"
+       << "      \"cpu_time\": " << result.cpuTime << ",\n";
+    if (result.itemsPerSecond > 0) {
+      os << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+    }
+    os << "      \"time_unit\": \"ns\"\n"
+       << "    }";
+  }
+  os << "\n  ]\n"
+     << "}\n";
+}
+
+std::vector<Result>
+ReadJson(std::istream& is)
+{
+  static const std::map<std::string, double> units = {
+    {"ns", 1.0}, {"us", 1e3}, {"ms", 1e6}, {"s", 1e9}};
+
+  boost::property_tree::ptree json;
+  boost::property_tree::read_json(is, json);
+
+  std::vector<Result> results;
+  for (const auto& item : json.get_child("benchmarks")) {
+    const boost::property_tree::ptree& benchmark = item.second;
+    if (benchmark.get<std::string>("run_type", "iteration") != "iteration")
+      continue; // aggregates of Google Benchmark repetitions
+
+    auto unit = units.find(benchmark.get<std::string>("time_unit", "ns"));
+    double scale = unit != units.end() ? unit->second : 1.0;
+
+    results.push_back({benchmark.get<std::string>("name"),
+                       benchmark.get<uint64_t>("iterations", 0),
+                       scale * benchmark.get<double>("real_time"),
+                       scale * benchmark.get<double>("cpu_time", 0),
+                       benchmark.get<double>("items_per_second", 0)});
+  }
+  return results;
+}
+
+size_t
+Compare(std::ostream& os, const std::vector<Result>& results, const std::vector<Result>& baseline,
+        double threshold)
+{
+  std::map<std::string, const Result*> baselineByName;
+  for (const Result& result : baseline) {
+    baselineByName[result.name] = &result;
+  }
+
+  size_t nRegressions = 0;
+  os << std::left << std::setw(50) << "Benchmark" << std::right << std::setw(15) << "Baseline"
+     << std::setw(15) << "Current" << std::setw(10) << "Change" << "\n";
+
+  for (const Result& result : results) {
+    os << std::left << std::setw(50) << result.name << std::right << std::fixed
+       << std::setprecision(1);
+
+    auto old = baselineByName.find(result.name);
+    if (old == baselineByName.end() || old->second->realTime <= 0) {
+      os << std::setw(15) << "-" << std::setw(15) << result.realTime << std::setw(10) << "-"
+         << "  new\n";
+      continue;
+    }
+
+    double change = result.realTime / old->second->realTime - 1.0;
+    os << std::setw(15) << old->second->realTime << std::setw(15) << result.realTime
+       << std::setw(9) << std::showpos << 100 * change << std::noshowpos << "%";
+    if (change > threshold) {
+      os << "  REGRESSION";
+      nRegressions++;
+    }
+    else if (change < -threshold) {
+      os << "  improvement";
+    }
+    os << "\n";
+  }
+  os << std::defaultfloat;
+
+  return nRegressions;
+}
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
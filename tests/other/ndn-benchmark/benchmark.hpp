@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_OTHER_NDN_BENCHMARK_BENCHMARK_HPP
+#define NDNSIM_TESTS_OTHER_NDN_BENCHMARK_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+/**
+ * @brief State of a running benchmark, which controls the measured loop
+ *
+ * Benchmarks follow the style of Google Benchmark: untimed setup is followed by the loop
+ *
+ *     while (state.KeepRunning()) {
+ *       // measured code
+ *     }
+ *
+ * which runs the number of iterations chosen by the runner.
+ */
+class State {
+public:
+  explicit
+  State(uint64_t nIterations);
+
+  bool
+  KeepRunning()
+  {
+    if (m_iteration == 0) {
+      ResumeTiming();
+    }
+    if (m_iteration < m_nIterations) {
+      ++m_iteration;
+      return true;
+    }
+    PauseTiming();
+    return false;
+  }
+
+  /**
+   * @brief Stop the clock, e.g., to prepare input of the following iterations
+   */
+  void
+  PauseTiming();
+
+  void
+  ResumeTiming();
+
+  /**
+   * @brief Set number of items (e.g., packets) processed by all iterations, 0 if not applicable
+   */
+  void
+  SetItemsProcessed(uint64_t nItems)
+  {
+    m_nItems = nItems;
+  }
+
+  uint64_t
+  GetIterations() const
+  {
+    return m_nIterations;
+  }
+
+  uint64_t
+  GetItemsProcessed() const
+  {
+    return m_nItems;
+  }
+
+  /**
+   * @brief Get measured real (wall-clock) time in seconds
+   */
+  double
+  GetRealTime() const
+  {
+    return m_realTime;
+  }
+
+  /**
+   * @brief Get measured CPU time of the process in seconds
+   */
+  double
+  GetCpuTime() const
+  {
+    return m_cpuTime;
+  }
+
+private:
+  uint64_t m_nIterations;
+  uint64_t m_iteration;
+  uint64_t m_nItems;
+  bool m_isRunning;
+
+  std::chrono::steady_clock::time_point m_realStart;
+  std::clock_t m_cpuStart;
+  double m_realTime;
+  double m_cpuTime;
+};
+
+typedef std::function<void(State&)> Function;
+
+struct Benchmark {
+  std::string name;
+  Function function;
+};
+
+/**
+ * @brief Get all benchmarks registered with NDN_BENCHMARK, in the order of registration
+ */
+std::vector<Benchmark>&
+GetBenchmarks();
+
+/**
+ * @brief Registers a benchmark during static initialization
+ */
+class Registrar {
+public:
+  Registrar(const std::string& name, const Function& function);
+};
+
+struct Result {
+  std::string name;
+  uint64_t nIterations;
+  double realTime;       ///< nanoseconds per iteration
+  double cpuTime;        ///< nanoseconds per iteration
+  double itemsPerSecond; ///< 0 if the benchmark does not count items
+};
+
+/**
+ * @brief Run @p benchmark with increasing number of iterations until it runs for @p minTime
+ *        seconds, and repeat the measurement @p nRepetitions times
+ *
+ * @returns the repetition with the median real time
+ *
+ * Simulator, node list, and names are cleaned after every call of the benchmark function.
+ */
+Result
+Run(const Benchmark& benchmark, double minTime, int nRepetitions);
+
+/**
+ * @brief Write @p results in JSON format of Google Benchmark (--benchmark_format=json)
+ */
+void
+WriteJson(std::ostream& os, const std::vector<Result>& results);
+
+/**
+ * @brief Read results written by WriteJson
+ */
+std::vector<Result>
+ReadJson(std::istream& is);
+
+/**
+ * @brief Print comparison of @p results with @p baseline
+ *
+ * @returns number of benchmarks whose real time is more than @p threshold (relative) above the
+ *          baseline
+ */
+size_t
+Compare(std::ostream& os, const std::vector<Result>& results, const std::vector<Result>& baseline,
+        double threshold);
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
+
+#define NDN_BENCHMARK_CONCAT2(a, b) a##b
+#define NDN_BENCHMARK_CONCAT(a, b) NDN_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * @brief Register @p function (void(State&)) as a benchmark with the specified @p name
+ */
+#define NDN_BENCHMARK(name, function)                                                              \
+  static ::ns3::ndn::benchmark::Registrar NDN_BENCHMARK_CONCAT(g_benchmark, __LINE__)(name,       \
+                                                                                      function)
+
+#endif // NDNSIM_TESTS_OTHER_NDN_BENCHMARK_BENCHMARK_HPP
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+#include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/transport.hpp"
+
+#include "ns3/packet.h"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+static nfd::face::Transport::Packet
+MakeInterest()
+{
+  Interest interest("/prefix/component/%00%01");
+  interest.setNonce(10);
+  interest.setCanBePrefix(false);
+  lp::Packet lpPacket(interest.wireEncode());
+  return nfd::face::Transport::Packet(lpPacket.wireEncode());
+}
+
+static nfd::face::Transport::Packet
+MakeData()
+{
+  Data data("/prefix/component/%00%01");
+  data.setFreshnessPeriod(ndn::time::milliseconds(1000));
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  StackHelper::getKeyChain().sign(data);
+  lp::Packet lpPacket(data.wireEncode());
+  return nfd::face::Transport::Packet(lpPacket.wireEncode());
+}
+
+static void
+Serialize(State& state, const nfd::face::Transport::Packet& packet)
+{
+  while (state.KeepRunning()) {
+    Ptr<Packet> ns3Packet = Create<Packet>();
+    ns3Packet->AddHeader(BlockHeader(packet));
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+static void
+Deserialize(State& state, const nfd::face::Transport::Packet& packet)
+{
+  Ptr<Packet> ns3Packet = Create<Packet>();
+  ns3Packet->AddHeader(BlockHeader(packet));
+
+  while (state.KeepRunning()) {
+    BlockHeader header;
+    ns3Packet->PeekHeader(header);
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+NDN_BENCHMARK("BlockHeader/Serialize/Interest", [] (State& state) {
+    Serialize(state, MakeInterest());
+  });
+
+NDN_BENCHMARK("BlockHeader/Serialize/Data", [] (State& state) {
+    Serialize(state, MakeData());
+  });
+
+NDN_BENCHMARK("BlockHeader/Deserialize/Interest", [] (State& state) {
+    Deserialize(state, MakeInterest());
+  });
+
+NDN_BENCHMARK("BlockHeader/Deserialize/Data", [] (State& state) {
+    Deserialize(state, MakeData());
+  });
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
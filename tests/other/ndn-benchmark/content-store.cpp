@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+const size_t CS_SIZE = 1000;
+
+static Ptr<ContentStore>
+MakeContentStore(const std::string& policy)
+{
+  ObjectFactory factory("ns3::ndn::cs::" + policy);
+  factory.Set("MaxSize", StringValue(std::to_string(CS_SIZE)));
+  return factory.Create<ContentStore>();
+}
+
+static std::vector<shared_ptr<Data>>
+MakeData(size_t n)
+{
+  std::vector<shared_ptr<Data>> data;
+  for (size_t i = 0; i < n; i++) {
+    data.push_back(make_shared<Data>(Name("/prefix").appendNumber(i)));
+    data.back()->setContent(std::make_shared< ::ndn::Buffer>(1024));
+    StackHelper::getKeyChain().sign(*data.back());
+  }
+  return data;
+}
+
+static std::vector<shared_ptr<Interest>>
+MakeInterests(size_t first, size_t n)
+{
+  std::vector<shared_ptr<Interest>> interests;
+  for (size_t i = first; i < first + n; i++) {
+    interests.push_back(make_shared<Interest>(Name("/prefix").appendNumber(i)));
+    interests.back()->setCanBePrefix(false);
+  }
+  return interests;
+}
+
+/**
+ * @brief Look up Interests for Data in (full) content store, or for Data that are not cached
+ */
+static void
+Lookup(State& state, const std::string& policy, bool isHit)
+{
+  Ptr<ContentStore> cs = MakeContentStore(policy);
+  for (const auto& data : MakeData(CS_SIZE)) {
+    cs->Add(data);
+  }
+  const auto interests = MakeInterests(isHit ? 0 : CS_SIZE, CS_SIZE);
+
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    cs->Lookup(interests[i]);
+    i = (i + 1) % interests.size();
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+/**
+ * @brief Add Data of a working set 10 times larger than the content store (every insert evicts)
+ */
+static void
+Insert(State& state, const std::string& policy)
+{
+  Ptr<ContentStore> cs = MakeContentStore(policy);
+  const auto data = MakeData(10 * CS_SIZE);
+
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    cs->Add(data[i]);
+    i = (i + 1) % data.size();
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+static struct ContentStoreBenchmarkRegistrar {
+  ContentStoreBenchmarkRegistrar()
+  {
+    for (std::string policy : {"Lru", "Random", "Fifo", "Lfu", "Arc", "TwoQ", "S3Fifo"}) {
+      Registrar("ContentStore/" + policy + "/Hit", [policy] (State& state) {
+          Lookup(state, policy, true);
+        });
+      Registrar("ContentStore/" + policy + "/Miss", [policy] (State& state) {
+          Lookup(state, policy, false);
+        });
+      Registrar("ContentStore/" + policy + "/Insert", [policy] (State& state) {
+          Insert(state, policy);
+        });
+    }
+  }
+} g_contentStoreBenchmarkRegistrar;
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
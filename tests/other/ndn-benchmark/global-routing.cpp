@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
+
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+/**
+ * @brief Shortest paths from every node of @p size x @p size grid
+ *
+ * No origins are announced, so only the Dijkstra part of CalculateRoutes is measured, without
+ * FIB updates.
+ */
+static void
+Dijkstra(State& state, uint32_t size)
+{
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(size, size, p2p);
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+
+  while (state.KeepRunning()) {
+    GlobalRoutingHelper::CalculateRoutes();
+  }
+  state.SetItemsProcessed(state.GetIterations() * size * size);
+}
+
+NDN_BENCHMARK("GlobalRoutingHelper/Dijkstra/Grid10x10", [] (State& state) {
+    Dijkstra(state, 10);
+  });
+
+NDN_BENCHMARK("GlobalRoutingHelper/Dijkstra/Grid20x20", [] (State& state) {
+    Dijkstra(state, 20);
+  });
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+/**
+ * @brief Send and acknowledge sequence numbers, keeping @p window of them outstanding
+ *        (as consumer applications do)
+ */
+static void
+SentAck(State& state, uint32_t window)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttMeanDeviation>();
+  for (uint32_t seq = 0; seq < window; seq++) {
+    rtt->SentSeq(SequenceNumber32(seq), 1);
+  }
+
+  uint32_t seq = 0;
+  while (state.KeepRunning()) {
+    rtt->AckSeq(SequenceNumber32(seq));
+    rtt->SentSeq(SequenceNumber32(seq + window), 1);
+    seq++;
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+static void
+Measurement(State& state)
+{
+  Ptr<RttEstimator> rtt = CreateObject<RttMeanDeviation>();
+
+  uint32_t i = 0;
+  while (state.KeepRunning()) {
+    rtt->Measurement(MilliSeconds(10 + i % 100));
+    rtt->RetransmitTimeout();
+    i++;
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+NDN_BENCHMARK("RttEstimator/MeanDeviation/SentAck/1", [] (State& state) {
+    SentAck(state, 1);
+  });
+
+NDN_BENCHMARK("RttEstimator/MeanDeviation/SentAck/64", [] (State& state) {
+    SentAck(state, 64);
+  });
+
+NDN_BENCHMARK("RttEstimator/MeanDeviation/Measurement", &Measurement);
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
+
+#include "ns3/point-to-point-module.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+/**
+ * @brief L3RateTracer with trace sinks exposed, so they can be called directly
+ */
+class BenchmarkL3RateTracer : public L3RateTracer {
+public:
+  using L3RateTracer::L3RateTracer;
+  using L3RateTracer::InInterests;
+  using L3RateTracer::OutInterests;
+  using L3RateTracer::InData;
+  using L3RateTracer::OutData;
+};
+
+/**
+ * @brief Cost of a trace sink of L3RateTracer per packet, excluding the periodic output
+ */
+template<class Sink>
+static void
+L3RatePerPacket(State& state, const Sink& sink)
+{
+  NodeContainer nodes;
+  nodes.Create(2);
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  Ptr<Node> node = nodes.Get(0);
+  shared_ptr<Face> face = node->GetObject<L3Protocol>()->getFaceByNetDevice(node->GetDevice(0));
+  Ptr<BenchmarkL3RateTracer> tracer =
+    Create<BenchmarkL3RateTracer>(make_shared<std::ostringstream>(), node);
+
+  Interest interest("/prefix/%00%01");
+  interest.setCanBePrefix(false);
+  Data data("/prefix/%00%01");
+  data.setContent(std::make_shared< ::ndn::Buffer>(1024));
+  StackHelper::getKeyChain().sign(data);
+
+  while (state.KeepRunning()) {
+    sink(*tracer, interest, data, *face);
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+NDN_BENCHMARK("Tracer/L3Rate/InInterests", [] (State& state) {
+    L3RatePerPacket(state, [] (BenchmarkL3RateTracer& tracer, const Interest& interest,
+                               const Data&, const Face& face) {
+                      tracer.InInterests(interest, face);
+                    });
+  });
+
+NDN_BENCHMARK("Tracer/L3Rate/InData", [] (State& state) {
+    L3RatePerPacket(state, [] (BenchmarkL3RateTracer& tracer, const Interest&,
+                               const Data& data, const Face& face) {
+                      tracer.InData(data, face);
+                    });
+  });
+
+/**
+ * @brief Cost of writing a per-packet record of AppDelayTracer, as seen by the simulation thread
+ */
+static void
+AppDelayRecord(State& state, TraceFormat format, bool isAsync)
+{
+  auto os = make_shared<std::ofstream>("/dev/null");
+  shared_ptr<TraceWriter> writer = TraceWriter::Create(format, os, AppDelayTracer::GetSchema());
+  if (isAsync) {
+    writer = make_shared<AsyncTraceWriter>(writer);
+  }
+
+  uint32_t seqno = 0;
+  while (state.KeepRunning()) {
+    writer->Write({1.5, "1", 0, seqno++, "LastDelay", 0.0123, 12300.0, 1, 3});
+  }
+  writer->Flush();
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+NDN_BENCHMARK("Tracer/AppDelayRecord/Text", [] (State& state) {
+    AppDelayRecord(state, TraceFormat::TEXT, false);
+  });
+
+NDN_BENCHMARK("Tracer/AppDelayRecord/Binary", [] (State& state) {
+    AppDelayRecord(state, TraceFormat::BINARY, false);
+  });
+
+NDN_BENCHMARK("Tracer/AppDelayRecord/AsyncText", [] (State& state) {
+    AppDelayRecord(state, TraceFormat::TEXT, true);
+  });
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lru-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lfu-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/fifo-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/random-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/persistent-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/arc-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/two-queue-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/s3-fifo-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/tinylfu-policy.hpp"
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+using namespace ndnSIM;
+
+const size_t CACHE_SIZE = 1000;
+
+/**
+ * @brief Names /prefix/0 ... /prefix/<n-1>, which are used in a cycle
+ */
+static std::vector<Name>
+MakeNames(size_t n)
+{
+  std::vector<Name> names;
+  for (size_t i = 0; i < n; i++) {
+    names.push_back(Name("/prefix").appendNumber(i));
+  }
+  return names;
+}
+
+template<class PolicyTraits>
+class TrieBenchmark {
+public:
+  typedef trie_with_policy<Name, pointer_payload_traits<int>, PolicyTraits> Cache;
+
+  /**
+   * @brief Insert names of a working set 10 times larger than the cache (every insert evicts)
+   */
+  static void
+  Insert(State& state)
+  {
+    const std::vector<Name> names = MakeNames(10 * CACHE_SIZE);
+    Cache cache;
+    cache.getPolicy().set_max_size(CACHE_SIZE);
+
+    size_t i = 0;
+    while (state.KeepRunning()) {
+      cache.insert(names[i], &s_payload);
+      i = (i + 1) % names.size();
+    }
+    state.SetItemsProcessed(state.GetIterations());
+  }
+
+  /**
+   * @brief Look up cached names, updating the policy as content store does on a hit
+   */
+  static void
+  Lookup(State& state)
+  {
+    const std::vector<Name> names = MakeNames(CACHE_SIZE);
+    Cache cache;
+    cache.getPolicy().set_max_size(CACHE_SIZE);
+    for (const Name& name : names) {
+      cache.insert(name, &s_payload);
+    }
+
+    size_t i = 0;
+    while (state.KeepRunning()) {
+      typename Cache::iterator found = cache.find_exact(names[i]);
+      if (found != cache.end()) {
+        cache.getPolicy().lookup(found);
+      }
+      i = (i + 1) % names.size();
+    }
+    state.SetItemsProcessed(state.GetIterations());
+  }
+
+  /**
+   * @brief Erase cached names one by one, refilling the cache (untimed) when it gets empty
+   */
+  static void
+  Erase(State& state)
+  {
+    const std::vector<Name> names = MakeNames(CACHE_SIZE);
+    Cache cache;
+    cache.getPolicy().set_max_size(CACHE_SIZE);
+
+    size_t i = 0;
+    while (state.KeepRunning()) {
+      if (i == 0) {
+        state.PauseTiming();
+        for (const Name& name : names) {
+          cache.insert(name, &s_payload);
+        }
+        state.ResumeTiming();
+      }
+
+      cache.erase(names[i]);
+      i = (i + 1) % names.size();
+    }
+    state.SetItemsProcessed(state.GetIterations());
+  }
+
+  static void
+  Register()
+  {
+    Registrar("Trie/" + PolicyTraits::GetName() + "/Insert", &Insert);
+    Registrar("Trie/" + PolicyTraits::GetName() + "/Lookup", &Lookup);
+    Registrar("Trie/" + PolicyTraits::GetName() + "/Erase", &Erase);
+  }
+
+private:
+  static int s_payload;
+};
+
+template<class PolicyTraits>
+int TrieBenchmark<PolicyTraits>::s_payload = 0;
+
+static struct TrieBenchmarkRegistrar {
+  TrieBenchmarkRegistrar()
+  {
+    TrieBenchmark<lru_policy_traits>::Register();
+    TrieBenchmark<lfu_policy_traits>::Register();
+    TrieBenchmark<fifo_policy_traits>::Register();
+    TrieBenchmark<random_policy_traits>::Register();
+    TrieBenchmark<persistent_policy_traits>::Register();
+    TrieBenchmark<arc_policy_traits>::Register();
+    TrieBenchmark<two_queue_policy_traits>::Register();
+    TrieBenchmark<s3_fifo_policy_traits>::Register();
+    TrieBenchmark<tinylfu_policy_traits>::Register();
+  }
+} g_trieBenchmarkRegistrar;
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark.hpp"
+
+#include "ns3/ndnSIM/apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "ns3/string.h"
+
+namespace ns3 {
+namespace ndn {
+namespace benchmark {
+
+/**
+ * @brief Draw sequence numbers of ConsumerZipfMandelbrot from a catalog of @p nContents
+ */
+static void
+ZipfSample(State& state, uint32_t nContents)
+{
+  Ptr<ConsumerZipfMandelbrot> consumer = CreateObject<ConsumerZipfMandelbrot>();
+  consumer->SetAttribute("NumberOfContents", StringValue(std::to_string(nContents)));
+
+  while (state.KeepRunning()) {
+    consumer->GetNextSeq();
+  }
+  state.SetItemsProcessed(state.GetIterations());
+}
+
+NDN_BENCHMARK("ZipfMandelbrot/GetNextSeq/100", [] (State& state) {
+    ZipfSample(state, 100);
+  });
+
+NDN_BENCHMARK("ZipfMandelbrot/GetNextSeq/1000", [] (State& state) {
+    ZipfSample(state, 1000);
+  });
+
+NDN_BENCHMARK("ZipfMandelbrot/GetNextSeq/10000", [] (State& state) {
+    ZipfSample(state, 10000);
+  });
+
+} // namespace benchmark
+} // namespace ndn
+} // namespace ns3
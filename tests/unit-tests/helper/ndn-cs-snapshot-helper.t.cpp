@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-cs-snapshot-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_SNAPSHOT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "cs-snapshot.bin";
+
+class CsSnapshotHelperFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CsSnapshotHelperFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+  }
+
+  ~CsSnapshotHelperFixture()
+  {
+    boost::filesystem::remove(TEST_SNAPSHOT);
+  }
+
+  void
+  run()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "2.99s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    CsSnapshotHelper::ScheduleSave(Seconds(4.0), TEST_SNAPSHOT.string());
+
+    Simulator::Stop(Seconds(5.0));
+    Simulator::Run();
+  }
+
+  static CsSnapshotHelper::NodeSnapshot
+  makeContent(const std::vector<uint64_t>& seqs, time::milliseconds freshness)
+  {
+    CsSnapshotHelper::NodeSnapshot content;
+    for (uint64_t seq : seqs) {
+      auto data = make_shared<Data>(Name("/prefix").appendSequenceNumber(seq));
+      data->setFreshnessPeriod(freshness);
+      data->setContent(std::make_shared< ::ndn::Buffer>(100));
+      StackHelper::getKeyChain().sign(*data);
+      content.push_back(data);
+    }
+    return content;
+  }
+
+  void
+  createConsumerTopology()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    // no producer: only Data preloaded into the consumer node can satisfy the Interests
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", "5"}},
+            "2s", "100s"}
+      });
+  }
+
+  static std::vector<Name>
+  toNames(const CsSnapshotHelper::NodeSnapshot& content)
+  {
+    std::vector<Name> names;
+    for (const auto& data : content) {
+      names.push_back(data->getName());
+    }
+    return names;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnCsSnapshotHelper, CsSnapshotHelperFixture)
+
+BOOST_AUTO_TEST_CASE(OldContentStore)
+{
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "10");
+  run();
+
+  CsSnapshotHelper::Snapshot snapshot = CsSnapshotHelper::Read(TEST_SNAPSHOT.string());
+  BOOST_REQUIRE_EQUAL(snapshot.size(), 2);
+
+  for (const std::string& node : {"1", "2"}) {
+    uint32_t nodeId = getNode(node)->GetId();
+    BOOST_REQUIRE(snapshot.find(nodeId) != snapshot.end());
+
+    std::vector<Name> saved = toNames(snapshot[nodeId]);
+    std::vector<Name> expected = toNames(CsSnapshotHelper::GetContent(getNode(node)));
+    BOOST_CHECK_EQUAL(saved.size(), 10);
+    BOOST_CHECK_EQUAL_COLLECTIONS(saved.begin(), saved.end(), expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NfdContentStore)
+{
+  getStackHelper().setCsSize(10);
+  run();
+
+  CsSnapshotHelper::Snapshot snapshot = CsSnapshotHelper::Read(TEST_SNAPSHOT.string());
+  BOOST_REQUIRE_EQUAL(snapshot.size(), 2);
+
+  for (const std::string& node : {"1", "2"}) {
+    uint32_t nodeId = getNode(node)->GetId();
+    std::vector<Name> saved = toNames(snapshot[nodeId]);
+    std::vector<Name> expected = toNames(CsSnapshotHelper::GetContent(getNode(node)));
+    BOOST_CHECK_EQUAL(saved.size(), 10);
+    BOOST_CHECK_EQUAL_COLLECTIONS(saved.begin(), saved.end(), expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LoadIntoRunningStack)
+{
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "10");
+  createConsumerTopology();
+
+  CsSnapshotHelper::NodeSnapshot content = makeContent({3, 1, 4, 0, 2}, time::seconds(10));
+  CsSnapshotHelper::Write({{getNode("1")->GetId(), content}}, TEST_SNAPSHOT.string());
+  Simulator::Schedule(Seconds(1.0), &CsSnapshotHelper::Load, TEST_SNAPSHOT.string());
+
+  Simulator::Stop(Seconds(0.5));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(CsSnapshotHelper::GetContent(getNode("1")).size(), 0);
+
+  // policy order of the snapshot is restored
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+  std::vector<Name> expected = toNames(content);
+  std::vector<Name> loaded = toNames(CsSnapshotHelper::GetContent(getNode("1")));
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+
+  // preloaded Data satisfy Interests and take part in the replacement policy
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 0);
+
+  expected = toNames(makeContent({0, 1, 2, 3, 4}, time::seconds(10)));
+  loaded = toNames(CsSnapshotHelper::GetContent(getNode("1")));
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(PreloadOnInstall)
+{
+  // nodes get IDs in the order of creation, the consumer node is created first
+  CsSnapshotHelper::NodeSnapshot content = makeContent({3, 1, 4, 0, 2}, time::seconds(10));
+  CsSnapshotHelper::Write({{0, content}}, TEST_SNAPSHOT.string());
+
+  getStackHelper().setCsSize(10);
+  getStackHelper().setCsSnapshot(TEST_SNAPSHOT.string());
+  createConsumerTopology();
+  BOOST_REQUIRE_EQUAL(getNode("1")->GetId(), 0);
+
+  // NFD's content store is saved and preloaded in name order
+  std::vector<Name> expected = toNames(makeContent({0, 1, 2, 3, 4}, time::seconds(10)));
+  std::vector<Name> loaded = toNames(CsSnapshotHelper::GetContent(getNode("1")));
+  BOOST_CHECK_EQUAL_COLLECTIONS(loaded.begin(), loaded.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(CsSnapshotHelper::GetContent(getNode("2")).size(), 0);
+
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getCounters().nOutInterests, 0);
+}
+
+BOOST_AUTO_TEST_CASE(PreloadRestartsFreshness)
+{
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Freshness::Lru", "MaxSize", "10",
+                                      "CleaningInterval", "0s");
+  createConsumerTopology();
+
+  CsSnapshotHelper::NodeSnapshot content = makeContent({0, 1, 2, 3, 4}, time::seconds(2));
+  CsSnapshotHelper::Write({{getNode("1")->GetId(), content}}, TEST_SNAPSHOT.string());
+  Simulator::Schedule(Seconds(1.0), &CsSnapshotHelper::Load, TEST_SNAPSHOT.string());
+
+  // FreshnessPeriod counts from the preload time (1s)
+  Simulator::Stop(Seconds(2.9));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getNode("1")->GetObject<ContentStore>()->GetSize(), 5);
+
+  Simulator::Stop(Seconds(0.2));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getNode("1")->GetObject<ContentStore>()->GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,261 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-global-routing-graph.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "model/ndn-global-router.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRoutingGraphFixture : public CleanupFixture
+{
+public:
+  /**
+   * @brief Create random topology of nodes connected with point-to-point links and multi-access
+   *        channels, with random face metrics (small, so that there are many equal-cost paths)
+   */
+  GlobalRoutingGraphFixture()
+    : m_random(42)
+  {
+    const uint32_t nNodes = 40;
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    // not necessarily connected, so some vertices are unreachable
+    std::uniform_int_distribution<uint32_t> anyNode(0, nNodes - 1);
+    PointToPointHelper p2p;
+    for (int i = 0; i < 55; i++) {
+      uint32_t a = anyNode(m_random);
+      uint32_t b = anyNode(m_random);
+      if (a != b)
+        p2p.Install(nodes.Get(a), nodes.Get(b));
+    }
+
+    std::vector<uint32_t> order(nNodes);
+    for (uint32_t i = 0; i < nNodes; i++) {
+      order[i] = i;
+    }
+    SimpleNetDeviceHelper lanHelper;
+    for (int i = 0; i < 3; i++) {
+      std::shuffle(order.begin(), order.end(), m_random);
+      NodeContainer lanNodes;
+      for (int j = 0; j < 4; j++) {
+        lanNodes.Add(nodes.Get(order[j]));
+      }
+      lanHelper.Install(lanNodes, CreateObject<SimpleChannel>());
+    }
+
+    ndn::StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+
+    std::uniform_int_distribution<uint32_t> anyMetric(1, 3);
+    for (uint32_t i = 0; i < nNodes; i++) {
+      auto ndn = nodes.Get(i)->GetObject<L3Protocol>();
+      for (auto& face : ndn->getForwarder()->getFaceTable()) {
+        face.setMetric(anyMetric(m_random));
+      }
+    }
+  }
+
+  /**
+   * @brief Calculate shortest paths using Bellman-Ford, selecting the lowest first hop of all
+   *        equal-cost paths
+   * @param excluded vertex whose edges are ignored
+   */
+  static GlobalRoutingGraph::ShortestPaths
+  calculateReference(const GlobalRoutingGraph& graph, uint32_t source,
+                     uint32_t excluded = GlobalRoutingGraph::INVALID)
+  {
+    GlobalRoutingGraph::ShortestPaths paths;
+    paths.distances.assign(graph.GetNVertices(), GlobalRoutingGraph::UNREACHABLE);
+    paths.firstHops.assign(graph.GetNVertices(), GlobalRoutingGraph::INVALID);
+    paths.distances[source] = 0;
+
+    // relax all edges until nothing changes, first distances, then first hops of the shortest paths
+    auto relax = [&](const std::function<bool(uint32_t, uint32_t, uint32_t)>& update) {
+      for (bool isUpdated = true; isUpdated;) {
+        isUpdated = false;
+        for (uint32_t from = 0; from < graph.GetNVertices(); from++) {
+          if (from == excluded || paths.distances[from] == GlobalRoutingGraph::UNREACHABLE)
+            continue;
+
+          for (uint32_t edge = graph.GetEdgesBegin(from); edge < graph.GetEdgesEnd(from); edge++) {
+            uint32_t to = graph.GetTarget(edge);
+            if (graph.IsEdgeUp(edge) && to != source && update(from, edge, to))
+              isUpdated = true;
+          }
+        }
+      }
+    };
+
+    relax([&](uint32_t from, uint32_t edge, uint32_t to) {
+      if (paths.distances[from] + graph.GetWeight(edge) >= paths.distances[to])
+        return false;
+      paths.distances[to] = paths.distances[from] + graph.GetWeight(edge);
+      return true;
+    });
+
+    relax([&](uint32_t from, uint32_t edge, uint32_t to) {
+      uint32_t firstHop = from == source ? edge : paths.firstHops[from];
+      if (paths.distances[from] + graph.GetWeight(edge) != paths.distances[to]
+          || firstHop >= paths.firstHops[to])
+        return false;
+      paths.firstHops[to] = firstHop;
+      return true;
+    });
+
+    return paths;
+  }
+
+  /**
+   * @brief Check that @p paths are the same as the reference ones, and that parents form the tree
+   */
+  static void
+  checkPaths(const GlobalRoutingGraph& graph, uint32_t source,
+             const GlobalRoutingGraph::ShortestPaths& paths)
+  {
+    auto reference = calculateReference(graph, source);
+    BOOST_CHECK_EQUAL_COLLECTIONS(paths.distances.begin(), paths.distances.end(),
+                                  reference.distances.begin(), reference.distances.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(paths.firstHops.begin(), paths.firstHops.end(),
+                                  reference.firstHops.begin(), reference.firstHops.end());
+
+    for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+      uint32_t parent = paths.parents[vertex];
+      if (vertex == source || paths.distances[vertex] == GlobalRoutingGraph::UNREACHABLE) {
+        BOOST_CHECK_EQUAL(parent, GlobalRoutingGraph::INVALID);
+        continue;
+      }
+      BOOST_REQUIRE_NE(parent, GlobalRoutingGraph::INVALID);
+      BOOST_CHECK_EQUAL(graph.GetTarget(parent), vertex);
+      BOOST_CHECK(graph.IsEdgeUp(parent));
+    }
+  }
+
+protected:
+  std::mt19937 m_random;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingGraph, GlobalRoutingGraphFixture)
+
+BOOST_AUTO_TEST_CASE(CalculateShortestPaths)
+{
+  GlobalRoutingGraph graph;
+  BOOST_CHECK_EQUAL(graph.GetNVertices(), 43);
+
+  for (uint32_t source = 0; source < graph.GetNVertices(); source++) {
+    GlobalRoutingGraph::ShortestPaths paths;
+    graph.CalculateShortestPaths(source, paths);
+    checkPaths(graph, source, paths);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GetDistancesWithout)
+{
+  GlobalRoutingGraph graph;
+
+  std::vector<uint32_t> sources;
+  for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+    sources.push_back(vertex);
+  }
+  graph.CacheDistances(sources, 4);
+
+  for (uint32_t source = 0; source < graph.GetNVertices(); source++) {
+    BOOST_CHECK(graph.GetDistances(source) == calculateReference(graph, source).distances);
+
+    for (uint32_t excluded = 0; excluded < graph.GetNVertices(); excluded++) {
+      if (excluded == source)
+        continue;
+
+      std::unordered_map<uint32_t, uint32_t> changed;
+      graph.GetDistancesWithout(source, excluded, changed);
+
+      std::vector<uint32_t> distances = graph.GetDistances(source);
+      for (const auto& entry : changed) {
+        BOOST_CHECK_NE(entry.second, distances[entry.first]);
+        distances[entry.first] = entry.second;
+      }
+
+      auto reference = calculateReference(graph, source, excluded);
+      BOOST_CHECK_EQUAL_COLLECTIONS(distances.begin(), distances.end(),
+                                    reference.distances.begin(), reference.distances.end());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UpdateShortestPaths)
+{
+  GlobalRoutingGraph graph;
+
+  std::vector<GlobalRoutingGraph::ShortestPaths> paths(graph.GetNVertices());
+  for (uint32_t source = 0; source < graph.GetNVertices(); source++) {
+    graph.CalculateShortestPaths(source, paths[source]);
+  }
+
+  // edges are brought down and up in random order, some edges go down several times
+  uint32_t nEdges = graph.GetEdgesEnd(graph.GetNVertices() - 1);
+  std::uniform_int_distribution<uint32_t> anyEdge(0, nEdges - 1);
+  for (int i = 0; i < 100; i++) {
+    uint32_t edge = anyEdge(m_random);
+    graph.SetEdgeUp(edge, !graph.IsEdgeUp(edge));
+
+    for (uint32_t source = 0; source < graph.GetNVertices(); source++) {
+      auto before = paths[source];
+      GlobalRoutingGraph::PreviousPaths previous;
+      graph.UpdateShortestPaths(source, edge, paths[source], previous);
+      checkPaths(graph, source, paths[source]);
+
+      // every vertex with a different first hop or distance is reported with the previous ones
+      for (uint32_t vertex = 0; vertex < graph.GetNVertices(); vertex++) {
+        auto label = std::make_pair(paths[source].firstHops[vertex],
+                                    paths[source].distances[vertex]);
+        auto previousLabel = std::make_pair(before.firstHops[vertex], before.distances[vertex]);
+        if (label == previousLabel)
+          continue;
+
+        BOOST_REQUIRE_EQUAL(previous.count(vertex), 1);
+        BOOST_CHECK(previous.at(vertex) == previousLabel);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
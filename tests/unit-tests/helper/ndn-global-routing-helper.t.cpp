@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 #include "helper/ndn-stack-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
@@ -37,6 +38,11 @@
 
 #include <boost/filesystem.hpp>
 
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+
 namespace ns3 {
 namespace ndn {
 
@@ -54,6 +60,68 @@ public:
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
   }
+
+  /**
+   * @brief Create nodes A4, B4, and C4 connected with links of the given metrics, and install
+   *        NDN stack and GlobalRouter on all of them
+   */
+  void
+  createTriangle(uint16_t metricAB, uint16_t metricAC, uint16_t metricBC)
+  {
+    ofstream file1(TEST_TOPO_TXT.string().c_str());
+    file1 << "router\n\n"
+          << "#node city  y x mpi-partition\n"
+          << "A4  NA  1 1 1\n"
+          << "B4  NA  80  -40 1\n"
+          << "C4  NA  80  40  1\n\n"
+          << "link\n\n"
+          << "# from  to  capacity  metric  delay queue\n"
+          << "A4      B4  10Mbps    " << metricAB << " 1ms 100\n"
+          << "A4      C4  10Mbps    " << metricAC << " 1ms 100\n"
+          << "B4      C4  10Mbps    " << metricBC << " 1ms 100\n";
+    file1.close();
+
+    AnnotatedTopologyReader topologyReader("");
+    topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+    topologyReader.Read();
+
+    ndn::StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    topologyReader.ApplyOspfMetric();
+
+    ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+  }
+
+  typedef std::map<std::string, uint64_t> Costs;
+
+  /**
+   * @brief Get costs of the routes of @p nodeName towards @p prefix, by name of the node on the
+   *        other side of the face (or name of the channel, if it is a multi-access channel)
+   */
+  Costs
+  getCosts(const std::string& nodeName, const Name& prefix = "/prefix")
+  {
+    Costs costs;
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    const auto& entry = node->GetObject<L3Protocol>()->getForwarder()->getFib()
+                          .findLongestPrefixMatch(prefix);
+    for (const auto& nextHop : entry.getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      std::string other = Names::FindName(channel);
+      if (channel->GetNDevices() == 2) {
+        Ptr<Node> otherNode = channel->GetDevice(0)->GetNode() == node ?
+                                channel->GetDevice(1)->GetNode() : channel->GetDevice(0)->GetNode();
+        other = Names::FindName(otherNode);
+      }
+      costs[other] = nextHop.getCost();
+    }
+    return costs;
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingHelper, GlobalRoutingHelperFixture)
@@ -190,6 +258,219 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  createTriangle(100, 50, 1);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  // every face gets a route with the cost of the path that does not return to the node
+  BOOST_CHECK(getCosts("A4") == Costs({{"C4", 50}, {"B4", 101}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"C4", 1}, {"A4", 150}}));
+
+  // face metrics are not modified
+  for (const auto& nodeName : {"A4", "B4"}) {
+    auto ndn = Names::Find<Node>(nodeName)->GetObject<ndn::L3Protocol>();
+    for (const auto& face : ndn->getForwarder()->getFaceTable()) {
+      BOOST_CHECK_NE(face.getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLfidRoutes)
+{
+  createTriangle(1, 1, 10);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndn::GlobalRoutingHelper::CalculateLfidRoutes();
+
+  // distances from neighbors must not go back through the node: B4 is 10 away from C4 without
+  // A4 (not 2), and A4 is 1 away without B4
+  BOOST_CHECK(getCosts("A4") == Costs({{"C4", 1}, {"B4", 11}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"A4", 2}, {"C4", 10}}));
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesWithEqualCostPaths)
+{
+  // IDs of the nodes do not follow the order of their faces, so the selected paths do not depend
+  // on the order in which nodes are visited by the shortest path calculation
+  NodeContainer nodes;
+  nodes.Create(5);
+  Names::Add("S", nodes.Get(0));
+  Names::Add("B", nodes.Get(1));
+  Names::Add("A", nodes.Get(2));
+  Names::Add("D", nodes.Get(3));
+  Names::Add("E", nodes.Get(4));
+
+  // S -- A -- D and S -- B -- D are equal-cost paths; A, B, and E share multi-access channel lan
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(2));
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(2), nodes.Get(3));
+  p2p.Install(nodes.Get(1), nodes.Get(3));
+
+  Ptr<SimpleChannel> lan = CreateObject<SimpleChannel>();
+  Names::Add("lan", lan);
+  SimpleNetDeviceHelper lanHelper;
+  lanHelper.Install(NodeContainer(nodes.Get(2), nodes.Get(1), nodes.Get(4)), lan);
+
+  // all faces get metric 1
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/s", nodes.Get(0));
+  ndnGlobalRoutingHelper.AddOrigins("/d", nodes.Get(3));
+  ndnGlobalRoutingHelper.AddOrigins("/e", nodes.Get(4));
+
+  // among equal-cost paths, the one via the face created first is selected; with any number of
+  // threads the same next hops are installed again, so no next hops are added
+  for (uint32_t nThreads : {1, 4}) {
+    ndn::GlobalRoutingHelper::SetNThreads(nThreads);
+    ndn::GlobalRoutingHelper::CalculateRoutes();
+
+    BOOST_CHECK(getCosts("S", "/d") == Costs({{"A", 2}}));
+    BOOST_CHECK(getCosts("D", "/s") == Costs({{"A", 2}}));
+    BOOST_CHECK(getCosts("S", "/e") == Costs({{"A", 2}}));
+    BOOST_CHECK(getCosts("D", "/e") == Costs({{"A", 2}}));
+
+    // edges from multi-access channel add no cost
+    BOOST_CHECK(getCosts("E", "/s") == Costs({{"lan", 2}}));
+    BOOST_CHECK(getCosts("E", "/d") == Costs({{"lan", 2}}));
+    BOOST_CHECK(getCosts("B", "/e") == Costs({{"lan", 1}}));
+    BOOST_CHECK(getCosts("B", "/d") == Costs({{"D", 1}}));
+    BOOST_CHECK(getCosts("A", "/s") == Costs({{"S", 1}}));
+  }
+
+  ndn::GlobalRoutingHelper::SetNThreads(0);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesInParallel)
+{
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-abilene.txt");
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOriginsForAll();
+
+  auto getNextHops = [] {
+    std::set<std::tuple<uint32_t, Name, nfd::FaceId, uint64_t>> nextHops;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+      for (const auto& entry : ndn->getForwarder()->getFib()) {
+        for (const auto& nextHop : entry.getNextHops()) {
+          nextHops.insert(std::make_tuple((*node)->GetId(), entry.getPrefix(),
+                                          nextHop.getFace().getId(), nextHop.getCost()));
+        }
+      }
+    }
+    return nextHops;
+  };
+
+  ndn::GlobalRoutingHelper::SetNThreads(1);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  auto sequential = getNextHops();
+  BOOST_CHECK_GT(sequential.size(), 0);
+
+  // the same next hops must be selected, otherwise FIBs would get additional ones
+  ndn::GlobalRoutingHelper::SetNThreads(4);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(getNextHops() == sequential);
+
+  ndn::GlobalRoutingHelper::SetNThreads(0);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateRoutesOnLinkChanges)
+{
+  createTriangle(100, 50, 1);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndn::GlobalRoutingHelper::SetIncremental(true);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  auto costsA = getCosts("A4");
+  auto costsB = getCosts("B4");
+  BOOST_CHECK_EQUAL(costsA.size(), 1);
+  BOOST_CHECK_EQUAL(costsA["C4"], 50);
+  BOOST_CHECK_EQUAL(costsB.size(), 1);
+  BOOST_CHECK_EQUAL(costsB["C4"], 1);
+
+  // the stale next hop is replaced, not just complemented
+  LinkControlHelper::FailLinkByName("A4", "C4");
+  BOOST_CHECK_EQUAL(getCosts("A4").size(), 1);
+  BOOST_CHECK_EQUAL(getCosts("A4")["B4"], 101);
+  BOOST_CHECK(getCosts("B4") == costsB);
+
+  // origin is no longer reachable
+  LinkControlHelper::FailLinkByName("B4", "C4");
+  BOOST_CHECK_EQUAL(getCosts("A4").size(), 0);
+  BOOST_CHECK_EQUAL(getCosts("B4").size(), 0);
+
+  LinkControlHelper::UpLinkByName("B4", "C4");
+  BOOST_CHECK_EQUAL(getCosts("A4").size(), 1);
+  BOOST_CHECK_EQUAL(getCosts("A4")["B4"], 101);
+  BOOST_CHECK(getCosts("B4") == costsB);
+
+  LinkControlHelper::UpLinkByName("A4", "C4");
+  BOOST_CHECK(getCosts("A4") == costsA);
+  BOOST_CHECK(getCosts("B4") == costsB);
+
+  ndn::GlobalRoutingHelper::SetIncremental(false);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateRoutesOfPrefixWithSeveralOrigins)
+{
+  createTriangle(100, 50, 1);
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("B4"));
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+  ndn::GlobalRoutingHelper::SetIncremental(true);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // both origins are reached via C4 from A4, the next hop gets the shorter distance
+  BOOST_CHECK(getCosts("A4") == Costs({{"C4", 50}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"C4", 1}}));
+  BOOST_CHECK(getCosts("C4") == Costs({{"B4", 1}}));
+
+  // both origins are now reached via B4 from A4
+  LinkControlHelper::FailLinkByName("A4", "C4");
+  BOOST_CHECK(getCosts("A4") == Costs({{"B4", 100}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"C4", 1}}));
+  BOOST_CHECK(getCosts("C4") == Costs({{"B4", 1}}));
+
+  // C4 is no longer reachable from A4, but the next hop still leads to B4
+  LinkControlHelper::FailLinkByName("B4", "C4");
+  BOOST_CHECK(getCosts("A4") == Costs({{"B4", 100}}));
+  BOOST_CHECK(getCosts("B4").empty());
+  BOOST_CHECK(getCosts("C4").empty());
+
+  // each origin is reached via a different face
+  LinkControlHelper::UpLinkByName("A4", "C4");
+  BOOST_CHECK(getCosts("A4") == Costs({{"B4", 100}, {"C4", 50}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"A4", 150}}));
+  BOOST_CHECK(getCosts("C4") == Costs({{"A4", 150}}));
+
+  LinkControlHelper::UpLinkByName("B4", "C4");
+  BOOST_CHECK(getCosts("A4") == Costs({{"C4", 50}}));
+  BOOST_CHECK(getCosts("B4") == Costs({{"C4", 1}}));
+  BOOST_CHECK(getCosts("C4") == Costs({{"B4", 1}}));
+
+  ndn::GlobalRoutingHelper::SetIncremental(false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
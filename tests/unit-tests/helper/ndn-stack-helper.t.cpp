@@ -62,6 +62,41 @@ BOOST_AUTO_TEST_CASE(TestNfdContentStorePolicy)
   BOOST_CHECK_EQUAL(protoNode1->getForwarder()->getCs().getPolicy()->getName(), "priority_fifo");
 }
 
+BOOST_FIXTURE_TEST_CASE(TestTrieContentStorePolicy, ScenarioHelperWithCleanupFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().setCsSize(10);
+  getStackHelper().setPolicy("ndnSIM::cs::arc");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "4.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(5.5));
+  Simulator::Run();
+
+  const ::nfd::Cs& cs = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getCs();
+  BOOST_CHECK_EQUAL(cs.getPolicy()->getName(), "ndnSIM::cs::arc");
+  // policy must evict through NFD's Content Store, keeping it within the limit
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
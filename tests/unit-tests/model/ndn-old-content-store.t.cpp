@@ -18,6 +18,12 @@
  **/
 
 
+#include "model/cs/content-store-partitioned.hpp"
+#include "model/cs/content-store-with-placement.hpp"
+#include "model/cs/content-store-with-stats.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "helper/ndn-cache-placement-helper.hpp"
+
 #include "../tests-common.hpp"
 
 namespace ns3 {
@@ -67,6 +73,417 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+BOOST_AUTO_TEST_CASE(FreshnessPolicy)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Freshness::Lru", "MaxSize", "100",
+                                      "CleaningInterval", "1s");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}, {"Freshness", "500ms"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // entries are cached while fresh, and only the last ~500ms worth of Data can be fresh
+  for (const std::string& node : {"1", "2"}) {
+    auto cs = getNode(node)->GetObject<ContentStore>();
+    BOOST_CHECK_GT(cs->GetSize(), 0);
+    BOOST_CHECK_LE(cs->GetSize(), 16);
+  }
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  // periodic sweeper must have removed everything after the traffic stopped
+  for (const std::string& node : {"1", "2"}) {
+    auto cs = getNode(node)->GetObject<ContentStore>();
+    BOOST_CHECK_EQUAL(cs->GetSize(), 0);
+    BOOST_CHECK(cs->Begin() == cs->End());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FreshnessPolicyExactExpiry)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Freshness::Lru", "MaxSize", "100",
+                                      "CleaningInterval", "0s");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}, {"Freshness", "500ms"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  for (const std::string& node : {"1", "2"}) {
+    BOOST_CHECK_GT(getNode(node)->GetObject<ContentStore>()->GetSize(), 0);
+  }
+
+  // run until 2.7s: last Data is cached before 2.1s and expires 500ms later, while a periodic
+  // sweeper started at ~0.02s with 1s interval would not wake up again until ~3.02s
+  Simulator::Stop(Seconds(1.2));
+  Simulator::Run();
+
+  for (const std::string& node : {"1", "2"}) {
+    BOOST_CHECK_EQUAL(getNode(node)->GetObject<ContentStore>()->GetSize(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TinyLfuAdmission)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru::TinyLfu", "MaxSize", "10");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "4.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(10.0));
+  Simulator::Run();
+
+  // a scan of one-hit wonders must not displace entries that were admitted first,
+  // while plain LRU would keep only the last 10 Data packets
+  auto cs = getNode("1")->GetObject<ContentStore>();
+  BOOST_CHECK_EQUAL(cs->GetSize(), 10);
+
+  size_t nFirst = 0;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    if (it->GetName().get(-1).toSequenceNumber() < 10) {
+      nFirst++;
+    }
+  }
+  BOOST_CHECK_GE(nFirst, 8); // doorkeeper false positives may let a couple through
+}
+
+BOOST_AUTO_TEST_CASE(PartitionedStore)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Partitioned", "MaxSize", "5");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  auto store = DynamicCast<cs::Partitioned>(getNode("1")->GetObject<ContentStore>());
+  BOOST_REQUIRE(store != 0);
+  store->AddPartition("/safety", "ns3::ndn::cs::Lru", 3, 0, true);
+
+  addRoutes({
+      {"1", "2", "/", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/bulk"}, {"Frequency", "10"}},
+          "0s", "4.99s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/safety"}, {"Frequency", "2"}},
+          "0s", "4.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(5.5));
+  Simulator::Run();
+
+  // bulk traffic is confined to the default partition
+  Ptr<ContentStore> defaultStore = store->GetPartitionStore("/bulk");
+  BOOST_CHECK_EQUAL(defaultStore->GetSize(), 5);
+
+  // pinned partition keeps the first entries, however much other traffic there is
+  Ptr<ContentStore> safetyStore = store->GetPartitionStore("/safety/any");
+  BOOST_CHECK(safetyStore != defaultStore);
+  BOOST_CHECK_EQUAL(safetyStore->GetSize(), 3);
+  for (auto it = safetyStore->Begin(); it != safetyStore->End(); it = safetyStore->Next(it)) {
+    BOOST_CHECK(Name("/safety").isPrefixOf(it->GetName()));
+    BOOST_CHECK_LT(it->GetName().get(-1).toSequenceNumber(), 3);
+  }
+
+  BOOST_CHECK_EQUAL(store->GetSize(), 8);
+  size_t nEntries = 0;
+  for (auto it = store->Begin(); it != store->End(); it = store->Next(it)) {
+    nEntries++;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 8);
+}
+
+BOOST_AUTO_TEST_CASE(PartitionedStoreByteQuota)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Partitioned", "MaxSize", "5");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  // room for three Data packets, which expire long before the next ones arrive
+  auto store = DynamicCast<cs::Partitioned>(getNode("1")->GetObject<ContentStore>());
+  BOOST_REQUIRE(store != 0);
+  store->AddPartition("/fresh", "ns3::ndn::cs::Freshness::Lru", 0, 3500, true);
+
+  addRoutes({
+      {"1", "2", "/", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/fresh"}, {"Frequency", "2"}},
+          "0s", "4.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/"}, {"PayloadSize", "1024"}, {"Freshness", "200ms"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(4.6));
+  Simulator::Run();
+
+  // bytes of expired entries are released, so the pinned partition keeps accepting new Data
+  Ptr<ContentStore> freshStore = store->GetPartitionStore("/fresh");
+  BOOST_REQUIRE_EQUAL(freshStore->GetSize(), 1);
+  BOOST_CHECK_EQUAL(freshStore->Begin()->GetName().get(-1).toSequenceNumber(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(LeaveCopyDownPlacement)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Placement::Lru", "Strategy", "Lcd",
+                                      "MaxSize", "100");
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+      {"3", "4"},
+    });
+
+  addRoutes({
+      {"1", "2", "/", 1},
+      {"2", "3", "/", 1},
+      {"3", "4", "/", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1.99s"},
+      {"4", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+
+  // only the node next to the producer keeps a copy
+  BOOST_CHECK_EQUAL(getNode("1")->GetObject<ContentStore>()->GetSize(), 0);
+  BOOST_CHECK_EQUAL(getNode("2")->GetObject<ContentStore>()->GetSize(), 0);
+  BOOST_CHECK_EQUAL(getNode("3")->GetObject<ContentStore>()->GetSize(), 20);
+  BOOST_CHECK_EQUAL(getNode("4")->GetObject<ContentStore>()->GetSize(), 0);
+
+  CachePlacementHelper::Redundancy redundancy = CachePlacementHelper::MeasureRedundancy();
+  BOOST_CHECK_EQUAL(redundancy.nNodes, 1);
+  BOOST_CHECK_EQUAL(redundancy.nDistinct, 20);
+  BOOST_CHECK_EQUAL(redundancy.nCopies, 20);
+  BOOST_CHECK_EQUAL(redundancy.GetRatio(), 1.0);
+
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+  nodes.Add(getNode("2"));
+  nodes.Add(getNode("3"));
+  nodes.Add(getNode("4"));
+  std::map<uint32_t, double> betweenness = CachePlacementHelper::ComputeBetweenness(nodes);
+  BOOST_CHECK_EQUAL(betweenness[getNode("1")->GetId()], 0.0);
+  BOOST_CHECK_EQUAL(betweenness[getNode("2")->GetId()], 1.0);
+  BOOST_CHECK_EQUAL(betweenness[getNode("3")->GetId()], 1.0);
+  BOOST_CHECK_EQUAL(betweenness[getNode("4")->GetId()], 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(ProbCachePlacement)
+{
+  typedef cs::ContentStoreWithPlacement<ndnSIM::lru_policy_traits> PlacementStore;
+
+  ObjectFactory factory("ns3::ndn::cs::Placement::Lru");
+  factory.Set("Strategy", EnumValue(cs::PROB_CACHE));
+  factory.Set("TimesIn", DoubleValue(4.0));
+  Ptr<PlacementStore> store = DynamicCast<PlacementStore>(factory.Create<ContentStore>());
+  BOOST_REQUIRE(store != 0);
+
+  auto makeInterest = [] (const Name& name, uint64_t hopCount) {
+    auto interest = make_shared<Interest>(name);
+    interest->setTag(make_shared<lp::HopCountTag>(hopCount));
+    return interest;
+  };
+  auto makeData = [] (const Name& name, uint64_t hopCount) {
+    auto data = make_shared<Data>(name);
+    data->setTag(make_shared<lp::HopCountTag>(hopCount));
+    return data;
+  };
+
+  // Interest came 2 hops from the consumer, Data 3 hops from the producer: path of 5 hops,
+  // TimesIn = (5 - 3 + 1) / 4, CacheWeight = 3 / 5
+  BOOST_CHECK(store->Lookup(makeInterest("/prefix/1", 2)) == nullptr);
+  BOOST_CHECK_CLOSE(store->GetAdmissionProbability(*makeData("/prefix/1", 3)), 0.45, 0.001);
+
+  // Interest was not seen (node next to the consumer): path of 3 hops, TimesIn = 1 / 4
+  BOOST_CHECK_CLOSE(store->GetAdmissionProbability(*makeData("/prefix/2", 3)), 0.25, 0.001);
+
+  // node of the producer never caches, the probability is capped at 1
+  BOOST_CHECK_EQUAL(store->GetAdmissionProbability(*makeData("/prefix/3", 0)), 0.0);
+  BOOST_CHECK(store->Lookup(makeInterest("/prefix/4", 20)) == nullptr);
+  BOOST_CHECK_EQUAL(store->GetAdmissionProbability(*makeData("/prefix/4", 20)), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(ProbCachePlacementOnPath)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  // with TimesIn of 1, every node on a 3-hop path is admitted with probability 1
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Placement::Lru", "Strategy", "ProbCache",
+                                      "TimesIn", "1", "MaxSize", "100");
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+      {"3", "4"},
+    });
+
+  addRoutes({
+      {"1", "2", "/", 1},
+      {"2", "3", "/", 1},
+      {"3", "4", "/", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1.99s"},
+      {"4", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getNode("1")->GetObject<ContentStore>()->GetSize(), 20);
+  BOOST_CHECK_EQUAL(getNode("2")->GetObject<ContentStore>()->GetSize(), 20);
+  BOOST_CHECK_EQUAL(getNode("3")->GetObject<ContentStore>()->GetSize(), 20);
+  BOOST_CHECK_EQUAL(getNode("4")->GetObject<ContentStore>()->GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LifetimeHistograms)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Stats::Lru", "MaxSize", "5",
+                                      "HistogramInterval", "100s");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  typedef cs::ContentStoreWithStats<ndnSIM::lru_policy_traits> StatsStore;
+  auto store = DynamicCast<StatsStore>(getNode("1")->GetObject<ContentStore>());
+  BOOST_REQUIRE(store != 0);
+  store->AddHistogramPrefix("/other");
+
+  addRoutes({
+      {"1", "2", "/", 1},
+    });
+
+  // the second consumer requests the same Data shortly after the first one
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1.99s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0.05s", "2.04s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+
+  const auto& histograms = store->GetHistograms();
+  BOOST_REQUIRE_EQUAL(histograms.size(), 2);
+
+  const auto& all = histograms.at("/");
+  BOOST_CHECK_EQUAL(all.lifetime.GetTotal(), 15);
+  // entries stay for 5 inter-arrival periods: 0.5s
+  BOOST_CHECK_EQUAL(all.lifetime.GetQuantile(0.5), LogHistogram::GetBucketLowerBound(
+                                                     LogHistogram::GetBucket(500000)));
+  BOOST_CHECK_GT(all.reuseDistance.GetTotal(), 0);
+
+  BOOST_CHECK_EQUAL(histograms.at("/other").lifetime.GetTotal(), 0);
+  BOOST_CHECK_EQUAL(histograms.at("/other").reuseDistance.GetTotal(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-event-accounting.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "events.txt";
+
+class EventAccountingFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  EventAccountingFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~EventAccountingFixture()
+  {
+    EventAccounting::Disable();
+    EventAccounting::Reset();
+    boost::filesystem::remove(TEST_TRACE);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsEventAccounting, EventAccountingFixture)
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  EventAccounting::Enable();
+
+  Simulator::Stop(Seconds(2.05));
+  Simulator::Run();
+
+  // 21 Interests (sent at 0s, 0.1s, ..., 2s) delivered to producer and 21 Data to consumer
+  const auto& delivery = EventAccounting::GetCounters(EventAccounting::APP_DELIVERY);
+  BOOST_CHECK_EQUAL(delivery.nScheduled, 42);
+  BOOST_CHECK_EQUAL(delivery.nExecuted, 42);
+  BOOST_CHECK_EQUAL(delivery.GetPending(), 0);
+
+  // the next Interest is always pending
+  const auto& send = EventAccounting::GetCounters(EventAccounting::APP_SEND);
+  BOOST_CHECK_EQUAL(send.nScheduled, send.nExecuted + 1);
+  BOOST_CHECK_EQUAL(send.GetPending(), 1);
+
+  BOOST_CHECK_GT(EventAccounting::GetCounters(EventAccounting::RETX_TIMER).nExecuted, 0);
+  BOOST_CHECK_EQUAL(EventAccounting::GetCounters(EventAccounting::TRACER).nScheduled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  Simulator::Stop(Seconds(2.05));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(EventAccounting::GetCounters(EventAccounting::APP_DELIVERY).nScheduled, 0);
+  BOOST_CHECK_EQUAL(EventAccounting::GetCounters(EventAccounting::APP_SEND).nScheduled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  EventAccounting::Install(TEST_TRACE.string(), Seconds(1.0));
+
+  Simulator::Stop(Seconds(2.05));
+  Simulator::Run();
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string line;
+  std::vector<std::string> sources;
+  BOOST_REQUIRE(std::getline(is, line));
+  BOOST_CHECK_EQUAL(line, "Time\tWallTime\tEventRate\tSpeedRatio\tSource\tScheduled\tExecuted"
+                          "\tPending\tScheduleRate");
+  while (std::getline(is, line)) {
+    std::istringstream row(line);
+    std::string time, wallTime, eventRate, speedRatio, source;
+    row >> time >> wallTime >> eventRate >> speedRatio >> source;
+    sources.push_back(time + " " + source);
+  }
+
+  BOOST_CHECK_EQUAL(sources.size(), 6);
+  BOOST_CHECK_EQUAL(sources.front(), "1 app-delivery");
+  BOOST_CHECK_EQUAL(sources.back(), "2 retx-timer");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-forwarding-profiler.hpp"
+
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ForwardingProfilerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ForwardingProfilerFixture()
+  {
+    // pipelines are profiled only on faces created after the profiler is enabled
+    ForwardingProfiler::Enable();
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "0.9s"}, // send just one packet
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~ForwardingProfilerFixture()
+  {
+    ForwardingProfiler::Disable();
+    ForwardingProfiler::Reset();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsForwardingProfiler, ForwardingProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(Stages)
+{
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // one Interest and one Data forwarded by the middle node
+  uint32_t node = getNode("2")->GetId();
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node, ForwardingProfiler::RECEIVE).nCalls, 2);
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node, ForwardingProfiler::DECODE).nCalls, 2);
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node,
+                                                 ForwardingProfiler::INCOMING_INTEREST).nCalls, 1);
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node,
+                                                 ForwardingProfiler::INCOMING_DATA).nCalls, 1);
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node, ForwardingProfiler::SEND).nCalls, 2);
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(node, ForwardingProfiler::ENCODE).nCalls, 2);
+
+  ForwardingProfiler::Stats receive = ForwardingProfiler::GetStats(node,
+                                                                   ForwardingProfiler::RECEIVE);
+  BOOST_CHECK_GE(receive.totalNs, receive.selfNs);
+  BOOST_CHECK_GE(receive.totalNs,
+                 ForwardingProfiler::GetStats(node, ForwardingProfiler::SEND).totalNs);
+
+  // consumer's Interest enters the forwarder from the application face
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(getNode("1")->GetId(),
+                                                 ForwardingProfiler::INCOMING_INTEREST).nCalls, 1);
+
+  std::ostringstream folded;
+  ForwardingProfiler::PrintFoldedStacks(folded);
+  std::string prefix = "node" + std::to_string(node) + ";receive;incoming-interest;send ";
+  BOOST_CHECK_NE(folded.str().find(prefix), std::string::npos);
+
+  std::ostringstream table;
+  ForwardingProfiler::PrintTable(table);
+  BOOST_CHECK_EQUAL(table.str().substr(0, table.str().find('\n')),
+                    "Node\tStage\tCalls\tTotalUs\tSelfUs\tMeanNs");
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  ForwardingProfiler::Disable();
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(ForwardingProfiler::GetStats(getNode("2")->GetId(),
+                                                 ForwardingProfiler::RECEIVE).nCalls, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
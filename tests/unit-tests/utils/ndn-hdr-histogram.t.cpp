@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-hdr-histogram.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsHdrHistogram)
+
+BOOST_AUTO_TEST_CASE(Buckets)
+{
+  for (size_t bucket = 1; bucket < 2000; bucket++) {
+    BOOST_CHECK_EQUAL(HdrHistogram::GetBucketUpperBound(bucket - 1) + 1,
+                      HdrHistogram::GetBucketLowerBound(bucket));
+  }
+
+  for (uint64_t value : {0, 1, 255, 256, 257, 511, 512, 1000, 123456789}) {
+    size_t bucket = HdrHistogram::GetBucket(value);
+    BOOST_CHECK_LE(HdrHistogram::GetBucketLowerBound(bucket), value);
+    BOOST_CHECK_GE(HdrHistogram::GetBucketUpperBound(bucket), value);
+    BOOST_CHECK_LE(HdrHistogram::GetBucketUpperBound(bucket) - value, value / 128);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Quantiles)
+{
+  std::mt19937 generator(1);
+  std::lognormal_distribution<double> distribution(10.0, 1.0);
+
+  std::vector<uint64_t> values;
+  HdrHistogram all;
+  HdrHistogram even;
+  HdrHistogram odd;
+  for (size_t i = 0; i < 10000; i++) {
+    uint64_t value = static_cast<uint64_t>(distribution(generator));
+    values.push_back(value);
+    all.Add(value);
+    (i % 2 == 0 ? even : odd).Add(value);
+  }
+  even.Merge(odd);
+  std::sort(values.begin(), values.end());
+
+  BOOST_CHECK_EQUAL(all.GetTotal(), values.size());
+  BOOST_CHECK_EQUAL(all.GetMax(), values.back());
+  BOOST_CHECK_EQUAL(all.GetQuantile(1.0), values.back());
+
+  for (double quantile : {0.5, 0.9, 0.99, 0.999}) {
+    uint64_t exact = values[static_cast<size_t>(quantile * values.size()) - 1];
+    uint64_t estimate = all.GetQuantile(quantile);
+    BOOST_CHECK_GE(estimate, exact);
+    BOOST_CHECK_LE(estimate - exact, exact / 100);
+
+    BOOST_CHECK_EQUAL(even.GetQuantile(quantile), estimate);
+  }
+
+  all.Reset();
+  BOOST_CHECK_EQUAL(all.GetTotal(), 0);
+  BOOST_CHECK_EQUAL(all.GetQuantile(0.5), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-mem-accounting.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "memory.txt";
+
+class MemAccountingFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  MemAccountingFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+  }
+
+  ~MemAccountingFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+  }
+
+  void
+  createScenario()
+  {
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsMemAccounting, MemAccountingFixture)
+
+BOOST_AUTO_TEST_CASE(Scopes)
+{
+  BOOST_CHECK_EQUAL(MemAccounting::GetCurrentSubsystem(), MemAccounting::OTHER);
+  BOOST_CHECK_EQUAL(MemAccounting::GetCurrentNode(), MemAccounting::NO_NODE);
+
+  {
+    MemAccounting::Scope pit(MemAccounting::PIT, 3);
+    BOOST_CHECK_EQUAL(MemAccounting::GetCurrentSubsystem(), MemAccounting::PIT);
+    BOOST_CHECK_EQUAL(MemAccounting::GetCurrentNode(), 3);
+
+    {
+      MemAccounting::Scope cs(MemAccounting::CS);
+      BOOST_CHECK_EQUAL(MemAccounting::GetCurrentSubsystem(), MemAccounting::CS);
+      BOOST_CHECK_EQUAL(MemAccounting::GetCurrentNode(), 3);
+
+      MemAccounting::Counters before = MemAccounting::GetCounters(3, MemAccounting::CS);
+      std::unique_ptr<char[]> block(new char[1000]);
+      MemAccounting::Counters after = MemAccounting::GetCounters(3, MemAccounting::CS);
+      if (MemAccounting::IsCounting()) {
+        BOOST_CHECK_EQUAL(after.nBytes - before.nBytes, 1000);
+        BOOST_CHECK_EQUAL(after.nAllocations - before.nAllocations, 1);
+
+        block.reset();
+        BOOST_CHECK_EQUAL(MemAccounting::GetCounters(3, MemAccounting::CS).nBytes, before.nBytes);
+      }
+    }
+
+    BOOST_CHECK_EQUAL(MemAccounting::GetCurrentSubsystem(), MemAccounting::PIT);
+  }
+
+  BOOST_CHECK_EQUAL(MemAccounting::GetCurrentSubsystem(), MemAccounting::OTHER);
+}
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  MemAccounting::Install(TEST_TRACE.string(), Seconds(1.0));
+  BOOST_CHECK(MemAccounting::IsEnabled());
+
+  createScenario();
+
+  Simulator::Stop(Seconds(1.05));
+  Simulator::Run();
+
+  std::ifstream is(TEST_TRACE.string().c_str());
+  std::string line;
+  BOOST_REQUIRE(std::getline(is, line));
+  BOOST_CHECK_EQUAL(line, "Time\tNode\tSubsystem\tEntries\tBytes\tAllocations");
+
+  std::map<std::string, std::string> entries;
+  while (std::getline(is, line)) {
+    std::istringstream row(line);
+    std::string time, node, subsystem, nEntries;
+    row >> time >> node >> subsystem >> nEntries;
+    BOOST_CHECK_EQUAL(time, "1");
+    entries[node + " " + subsystem] = nEntries;
+  }
+
+  BOOST_CHECK_EQUAL(entries["0 APP"], "1");
+  BOOST_CHECK_EQUAL(entries["1 APP"], "1");
+  BOOST_CHECK_EQUAL(entries.count("0 FIB"), 1);
+  BOOST_CHECK_EQUAL(entries.count("0 FACE"), 1);
+  BOOST_CHECK_EQUAL(entries.count("- OTHER"), MemAccounting::IsCounting() ? 1 : 0);
+}
+
+BOOST_AUTO_TEST_CASE(EnableWithoutRecords)
+{
+  MemAccounting::Enable();
+  BOOST_CHECK(MemAccounting::IsEnabled());
+
+  createScenario();
+
+  Simulator::Stop(Seconds(1.05));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(MemAccounting::GetEntries(0, MemAccounting::APP), 1);
+  BOOST_CHECK_EQUAL(MemAccounting::GetEntries(1, MemAccounting::APP), 1);
+  if (MemAccounting::IsCounting()) {
+    BOOST_CHECK_GT(MemAccounting::GetCounters(0, MemAccounting::FACE).nBytes, 0);
+    BOOST_CHECK_GT(MemAccounting::GetCounters(1, MemAccounting::CS).nBytes, 0);
+  }
+  BOOST_CHECK(!boost::filesystem::exists(TEST_TRACE));
+}
+
+BOOST_AUTO_TEST_CASE(ResetOnDestroy)
+{
+  MemAccounting::Enable();
+
+  std::unique_ptr<char[]> block;
+  {
+    MemAccounting::Scope cs(MemAccounting::CS, 3);
+    block.reset(new char[1000]);
+  }
+  if (MemAccounting::IsCounting()) {
+    BOOST_CHECK_GE(MemAccounting::GetCounters(3, MemAccounting::CS).nBytes, 1000);
+  }
+
+  Simulator::Destroy();
+  BOOST_CHECK(!MemAccounting::IsEnabled());
+
+  // the next simulation that uses the same node ID starts from zero, even when memory of the
+  // previous one is freed later
+  BOOST_CHECK_EQUAL(MemAccounting::GetCounters(3, MemAccounting::CS).nBytes, 0);
+  block.reset();
+  BOOST_CHECK_EQUAL(MemAccounting::GetCounters(3, MemAccounting::CS).nBytes, 0);
+  BOOST_CHECK_EQUAL(MemAccounting::GetCounters(3, MemAccounting::CS).nAllocations, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-virtual-payload.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsVirtualPayload, ScenarioHelperWithCleanupFixture)
+
+static shared_ptr<Data>
+makeData(size_t payloadSize, bool isVirtual)
+{
+  auto data = make_shared<Data>("/prefix/data");
+  data->setFreshnessPeriod(ndn::time::milliseconds(1000));
+  if (isVirtual) {
+    VirtualPayload::Set(*data, payloadSize);
+  }
+  else {
+    data->setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+  }
+  ndn::StackHelper::getKeyChain().sign(*data);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(EncodedSize)
+{
+  for (size_t payloadSize : {0, 1, 100, 250, 1024, 8000, 70000}) {
+    shared_ptr<Data> real = makeData(payloadSize, false);
+    shared_ptr<Data> virt = makeData(payloadSize, true);
+
+    BOOST_CHECK(!VirtualPayload::IsVirtual(*real));
+    BOOST_CHECK(VirtualPayload::IsVirtual(*virt));
+    BOOST_CHECK_EQUAL(VirtualPayload::GetSize(*virt), payloadSize);
+    BOOST_CHECK_LT(virt->wireEncode().size(), 200);
+
+    BOOST_CHECK_EQUAL(VirtualPayload::GetPadding(real->wireEncode()), 0);
+    BOOST_CHECK_EQUAL(VirtualPayload::GetEncodedSize(*real), real->wireEncode().size());
+    BOOST_CHECK_EQUAL(VirtualPayload::GetEncodedSize(*virt), real->wireEncode().size());
+
+    lp::Packet realLp(real->wireEncode());
+    realLp.add<lp::HopCountTagField>(3);
+    lp::Packet virtLp(virt->wireEncode());
+    virtLp.add<lp::HopCountTagField>(3);
+
+    BOOST_CHECK_EQUAL(VirtualPayload::GetPadding(realLp.wireEncode()), 0);
+    if (payloadSize >= 3) { // otherwise real Data is shorter than virtual
+      BOOST_CHECK_EQUAL(virtLp.wireEncode().size()
+                        + VirtualPayload::GetPadding(virtLp.wireEncode()),
+                        realLp.wireEncode().size());
+    }
+  }
+}
+
+static std::map<uint32_t, Time> g_delays;
+
+static void
+DataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+{
+  g_delays[app->GetId()] = delay;
+}
+
+BOOST_AUTO_TEST_CASE(SameDelayAsRealPayload)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  createTopology({
+      {"1", "2"},
+      {"1", "3"},
+    });
+
+  addRoutes({
+      {"1", "2", "/real", 1},
+      {"1", "3", "/virtual", 1},
+    });
+
+  // Data do not fit into MTU and are fragmented
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/real"}, {"MaxSeq", "1"}},
+          "0s", "10s"},
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/virtual"}, {"MaxSeq", "1"}},
+          "0s", "10s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/real"}, {"PayloadSize", "4000"}},
+          "0s", "10s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/virtual"}, {"PayloadSize", "4000"}, {"VirtualPayload", "true"}},
+          "0s", "10s"}
+    });
+
+  g_delays.clear();
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerCbr/"
+                                "LastRetransmittedInterestDataDelay",
+                                MakeCallback(&DataDelay));
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(g_delays.size(), 2);
+  Time real = g_delays.begin()->second;
+  Time virt = g_delays.rbegin()->second;
+
+  // transmission of 4KB over 10Mbps link adds ~3ms to 20ms propagation delay; NDNLP overhead of
+  // fragments is approximated
+  BOOST_CHECK_GT(real, MilliSeconds(23));
+  BOOST_CHECK_CLOSE(virt.ToDouble(Time::MS), real.ToDouble(Time::MS), 0.5);
+
+  // face byte counters include padding of virtual payload on both sides of the link
+  double realOut = getFace("2", "1")->getCounters().nOutBytes;
+  double virtOut = getFace("3", "1")->getCounters().nOutBytes;
+  BOOST_CHECK_GT(realOut, 4000);
+  BOOST_CHECK_CLOSE(virtOut, realOut, 3.0);
+
+  double realIn = getFace("1", "2")->getCounters().nInBytes;
+  double virtIn = getFace("1", "3")->getCounters().nInBytes;
+  BOOST_CHECK_CLOSE(virtIn, realIn, 3.0);
+  BOOST_CHECK_EQUAL(virtIn, virtOut);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/node.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyPartitioner, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Grid)
+{
+  // 10x10 grid, where links between 5th and 6th columns have much larger delay
+  const uint32_t size = 10;
+
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < size * size; i++) {
+    partitioner.AddVertex();
+  }
+  for (uint32_t row = 0; row < size; row++) {
+    for (uint32_t column = 0; column < size; column++) {
+      uint32_t vertex = row * size + column;
+      if (column + 1 < size)
+        partitioner.AddEdge(vertex, vertex + 1, 1.0, MilliSeconds(column == 4 ? 50 : 1));
+      if (row + 1 < size)
+        partitioner.AddEdge(vertex, vertex + size, 1.0, MilliSeconds(1));
+    }
+  }
+
+  partitioner.Partition(2);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutEdges(), size);
+  BOOST_CHECK_EQUAL(partitioner.GetCutWeight(), size);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(50));
+  BOOST_CHECK_EQUAL(partitioner.GetPartitionWeights()[0], 50);
+  BOOST_CHECK_EQUAL(partitioner.GetPartitionWeights()[1], 50);
+
+  partitioner.Partition(4);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(1));
+  for (double weight : partitioner.GetPartitionWeights()) {
+    BOOST_CHECK_LE(weight, 25 * 1.03);
+  }
+  // any balanced 4-way partition of the grid cuts at least 20 links, a random one ~75
+  BOOST_CHECK_LE(partitioner.GetNCutEdges(), 40);
+
+  partitioner.Partition(1);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutEdges(), 0);
+  BOOST_CHECK(partitioner.GetLookahead() == Time::Max());
+}
+
+BOOST_AUTO_TEST_CASE(VertexWeights)
+{
+  // two heavy vertices must end up in different partitions
+  TopologyPartitioner partitioner;
+  for (uint32_t i = 0; i < 8; i++) {
+    partitioner.AddVertex(i < 2 ? 10.0 : 1.0);
+  }
+  for (uint32_t i = 0; i < 8; i++) {
+    partitioner.AddEdge(i, (i + 1) % 8, 1.0, MilliSeconds(1));
+  }
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition(2, 0.1);
+  BOOST_CHECK_NE(partitions[0], partitions[1]);
+  BOOST_CHECK_EQUAL(partitioner.GetPartitionWeights()[0], 13);
+  BOOST_CHECK_EQUAL(partitioner.GetPartitionWeights()[1], 13);
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedTopology)
+{
+  AnnotatedTopologyReader topologyReader;
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-grid-3x3.txt");
+  topologyReader.SetPartitions(3);
+  NodeContainer nodes = topologyReader.Read();
+
+  BOOST_REQUIRE_EQUAL(nodes.GetN(), 9);
+  std::map<uint32_t, uint32_t> sizes;
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    sizes[nodes.Get(i)->GetSystemId()]++;
+  }
+  BOOST_CHECK_EQUAL(sizes.size(), 3);
+  for (const auto& size : sizes) {
+    BOOST_CHECK_EQUAL(size.second, 3);
+  }
+
+  const TopologyPartitioner& partitioner = topologyReader.GetPartitioner();
+  BOOST_CHECK_EQUAL(partitioner.GetNCutEdges(), 6);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(10));
+
+  std::ostringstream os;
+  partitioner.PrintReport(os);
+  BOOST_CHECK_EQUAL(os.str().substr(0, 28), "Partitions: 3, cut links: 6 ");
+}
+
+BOOST_AUTO_TEST_CASE(AnnotatedTopologyReadTwice)
+{
+  const boost::filesystem::path topoTxt = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+  boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  {
+    std::ofstream file(topoTxt.string().c_str());
+    file << "router\n"
+         << "A1 NA 1 1\n"
+         << "B1 NA 1 2\n"
+         << "link\n"
+         << "A1 B1 1Mbps 1 5ms 10\n";
+  }
+
+  // the second Read partitions only the nodes of the second file
+  AnnotatedTopologyReader topologyReader;
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-grid-3x3.txt");
+  topologyReader.SetPartitions(3);
+  topologyReader.Read();
+  topologyReader.SetFileName(topoTxt.string());
+  topologyReader.SetPartitions(2);
+  topologyReader.Read();
+  boost::filesystem::remove(topoTxt);
+
+  const TopologyPartitioner& partitioner = topologyReader.GetPartitioner();
+  BOOST_CHECK_EQUAL(partitioner.GetPartitions().size(), 2);
+  BOOST_CHECK_EQUAL(partitioner.GetNCutEdges(), 1);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
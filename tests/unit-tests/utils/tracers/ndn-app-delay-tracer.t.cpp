@@ -161,6 +161,36 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
 )STR"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllSummaries)
+{
+  AppDelayTracer::InstallAllSummaries(TEST_TRACE.string(), Seconds(2.5));
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    R"STR(Time	Node	AppId	Metric	Count	Mean	P50	P90	P99	P999	Max
+2.5	1	0	FullDelayUS	1	41796	41796	41796	41796	41796	41796
+2.5	1	0	LastDelayUS	1	41796	41796	41796	41796	41796	41796
+2.5	1	0	RetxCount	1	1	1	1	1	1	1
+2.5	1	0	HopCount	1	2	2	2	2	2	2
+2.5	2	0	FullDelayUS	1	0	0	0	0	0	0
+2.5	2	0	LastDelayUS	1	0	0	0	0	0	0
+2.5	2	0	RetxCount	1	1	1	1	1	1	1
+2.5	2	0	HopCount	1	0	0	0	0	0	0
+5	2	0	FullDelayUS	2	20898	20898	20898	20898	20898	20898
+5	2	0	LastDelayUS	2	20898	20898	20898	20898	20898	20898
+5	2	0	RetxCount	2	1	1	1	1	1	1
+5	2	0	HopCount	2	1	1	1	1	1	1
+)STR");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -18,10 +18,13 @@
  **/
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "utils/tracers/ndn-trace-reader.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
+#include <fstream>
+
 #include "../../tests-common.hpp"
 
 namespace ns3 {
@@ -119,6 +122,74 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(SharedSampler)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 0);
+
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+  BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 1);
+
+  // same period and phase, different output stream: still a single event
+  const boost::filesystem::path otherTrace = TEST_TRACE.string() + ".1";
+  L3RateTracer::Install(nodes, otherTrace.string(), Seconds(1));
+  BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 1);
+
+  {
+    Ptr<L3RateTracer> tracer = L3RateTracer::Install(getNode("1"),
+                                                     make_shared<std::ostringstream>(), Seconds(2));
+    BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 2);
+  }
+  BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 1);
+
+  L3RateTracer::Destroy();
+  BOOST_CHECK_EQUAL(TracerSampler::GetNEvents(), 0);
+
+  boost::filesystem::remove(otherTrace);
+}
+
+BOOST_AUTO_TEST_CASE(SamplerWithoutStream)
+{
+  // tracers installed with a file write through a background writer and register no stream
+  int nSamples = 0;
+  TracerSampler::Id id = TracerSampler::Register(Seconds(1), nullptr,
+                                                 [&nSamples] (std::ostream&) { ++nSamples; });
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  TracerSampler::Unregister(id);
+  BOOST_CHECK_EQUAL(nSamples, 2);
+}
+
+BOOST_AUTO_TEST_CASE(BinaryFormat)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  const boost::filesystem::path binaryTrace = TEST_TRACE.string() + ".bin";
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+  L3RateTracer::Install(nodes, binaryTrace.string(), Seconds(1), TraceFormat::BINARY);
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream binary(binaryTrace.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  std::ostringstream converted;
+  BOOST_CHECK_GT(BinaryTraceReader::ConvertToText(binary, converted), 0U);
+
+  std::ifstream text(TEST_TRACE.string().c_str());
+  std::ostringstream expected;
+  expected << text.rdbuf();
+  BOOST_CHECK_EQUAL(converted.str(), expected.str());
+
+  boost::filesystem::remove(binaryTrace);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
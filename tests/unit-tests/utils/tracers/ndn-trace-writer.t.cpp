@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-async-trace-writer.hpp"
+#include "utils/tracers/ndn-trace-reader.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnTraceWriter)
+
+static const TraceSchema SCHEMA = {
+  {"Time", TraceColumn::REAL},
+  {"Node", TraceColumn::STRING},
+  {"FaceId", TraceColumn::INTEGER},
+  {"Packets", TraceColumn::REAL},
+};
+
+static void
+writeRecords(TraceWriter& writer, size_t nRecords)
+{
+  for (size_t i = 0; i < nRecords; ++i) {
+    std::string node = "node" + std::to_string(i % 7);
+    writer.Write({i * 0.5, node, static_cast<int64_t>(i) - 1, 1.0 / (i + 1)});
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TextLayout)
+{
+  auto os = make_shared<std::ostringstream>();
+  TextTraceWriter writer(os, SCHEMA);
+  writer.Write({1.5, "node", -1, 0.8});
+  writer.Write({2.0, std::string("other"), uint32_t(257), 4.0});
+
+  BOOST_CHECK_EQUAL(os->str(), "1.5\tnode\t-1\t0.8\n"
+                               "2\tother\t257\t4\n");
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToText)
+{
+  // more than one block, with and without compression
+  const size_t nRecords = BinaryTraceWriter::BLOCK_SIZE * 2 + 10;
+
+  auto text = make_shared<std::ostringstream>();
+  *text << "Time\tNode\tFaceId\tPackets\n";
+  TextTraceWriter textWriter(text, SCHEMA);
+  writeRecords(textWriter, nRecords);
+
+  for (bool isCompressed : {true, false}) {
+    auto binary = make_shared<std::stringstream>();
+    {
+      BinaryTraceWriter binaryWriter(binary, SCHEMA, isCompressed);
+      writeRecords(binaryWriter, nRecords);
+    } // flushed on destruction
+
+    if (isCompressed) {
+      BOOST_CHECK_LT(binary->str().size(), text->str().size());
+    }
+
+    std::ostringstream converted;
+    BOOST_CHECK_EQUAL(BinaryTraceReader::ConvertToText(*binary, converted), nRecords);
+    BOOST_CHECK(converted.str() == text->str());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StreamingReader)
+{
+  auto binary = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(binary, SCHEMA);
+    writeRecords(writer, 3);
+  }
+
+  BinaryTraceReader reader(*binary);
+  BOOST_REQUIRE_EQUAL(reader.GetSchema().size(), SCHEMA.size());
+  BOOST_CHECK_EQUAL(reader.GetSchema()[1].name, "Node");
+  BOOST_CHECK_EQUAL(reader.GetSchema()[1].type, TraceColumn::STRING);
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetReal(0), 0.0);
+  BOOST_CHECK_EQUAL(reader.GetString(1), "node0");
+  BOOST_CHECK_EQUAL(reader.GetInteger(2), -1);
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetReal(0), 1.0);
+  BOOST_CHECK_EQUAL(reader.GetString(1), "node2");
+  BOOST_CHECK_EQUAL(reader.GetInteger(2), 1);
+  BOOST_CHECK_CLOSE(reader.GetReal(3), 1.0 / 3, 0.0001);
+
+  BOOST_CHECK(!reader.Next());
+}
+
+BOOST_AUTO_TEST_CASE(AsyncWriter)
+{
+  const size_t nRecords = 5000;
+
+  auto expected = make_shared<std::ostringstream>();
+  TextTraceWriter textWriter(expected, SCHEMA);
+  writeRecords(textWriter, nRecords);
+  std::string expectedHalf = expected->str();
+  writeRecords(textWriter, nRecords);
+
+  auto os = make_shared<std::ostringstream>();
+  {
+    // small ring to make the simulation side wait for the background thread
+    AsyncTraceWriter writer(make_shared<TextTraceWriter>(os, SCHEMA), 64);
+    writeRecords(writer, nRecords); // strings are temporaries, so they must be interned
+
+    writer.Flush();
+    BOOST_CHECK(os->str() == expectedHalf);
+
+    writeRecords(writer, nRecords);
+    BOOST_CHECK_EQUAL(writer.GetStats().nRecords, 2 * nRecords);
+    BOOST_CHECK_LE(writer.GetStats().maxOccupancy, 64);
+  } // flushed and stopped on destruction
+
+  BOOST_CHECK(os->str() == expected->str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
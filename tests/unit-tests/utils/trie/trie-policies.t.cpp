@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/arc-policy.hpp"
+#include "utils/trie/two-queue-policy.hpp"
+#include "utils/trie/s3-fifo-policy.hpp"
+
+#include <random>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using namespace ndnSIM;
+
+const size_t CACHE_SIZE = 100;
+const size_t TRACE_LENGTH = 50000;
+
+enum TraceType {
+  ZIPF,      ///< popularity-skewed requests only
+  SCAN,      ///< sequential scan, every name is requested once
+  ZIPF_SCAN, ///< popularity-skewed requests interleaved with a sequential scan
+};
+
+static std::vector<uint64_t>
+makeTrace(TraceType type)
+{
+  std::mt19937 rng(42);
+  std::vector<double> weights;
+  for (size_t rank = 1; rank <= 10 * CACHE_SIZE; rank++) {
+    weights.push_back(1.0 / rank);
+  }
+  std::discrete_distribution<uint64_t> zipf(weights.begin(), weights.end());
+
+  std::vector<uint64_t> trace;
+  uint64_t nextScanItem = 1000000;
+  for (size_t i = 0; i < TRACE_LENGTH; i++) {
+    if (type == ZIPF || (type == ZIPF_SCAN && i % 2 == 0)) {
+      trace.push_back(zipf(rng));
+    }
+    else {
+      trace.push_back(nextScanItem++);
+    }
+  }
+  return trace;
+}
+
+/**
+ * @brief Replay the trace through the cache and return the hit ratio
+ */
+template<class PolicyTraits>
+static double
+replay(TraceType type)
+{
+  typedef trie_with_policy<Name, pointer_payload_traits<int>, PolicyTraits> Cache;
+
+  static int payload = 0;
+  Cache cache;
+  cache.getPolicy().set_max_size(CACHE_SIZE);
+
+  size_t nHits = 0;
+  const std::vector<uint64_t> trace = makeTrace(type);
+  for (uint64_t item : trace) {
+    Name name = Name("/prefix").appendNumber(item);
+
+    typename Cache::iterator found = cache.find_exact(name);
+    if (found != cache.end()) {
+      cache.getPolicy().lookup(found);
+      nHits++;
+    }
+    else {
+      cache.insert(name, &payload);
+    }
+
+    BOOST_REQUIRE_LE(cache.getPolicy().size(), CACHE_SIZE);
+  }
+
+  double hitRatio = static_cast<double>(nHits) / trace.size();
+  BOOST_TEST_MESSAGE(PolicyTraits::GetName() << " trace " << type << " hit ratio " << hitRatio);
+  return hitRatio;
+}
+
+BOOST_AUTO_TEST_SUITE(UtilsTriePolicies)
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  double lruZipf = replay<lru_policy_traits>(ZIPF);
+  double lruMixed = replay<lru_policy_traits>(ZIPF_SCAN);
+
+  // the scan alone cannot produce any hits
+  BOOST_CHECK_EQUAL(replay<arc_policy_traits>(SCAN), 0);
+  BOOST_CHECK_EQUAL(replay<two_queue_policy_traits>(SCAN), 0);
+  BOOST_CHECK_EQUAL(replay<s3_fifo_policy_traits>(SCAN), 0);
+
+  // no worse than LRU without the scan
+  BOOST_CHECK_GE(replay<arc_policy_traits>(ZIPF), lruZipf);
+  BOOST_CHECK_GE(replay<two_queue_policy_traits>(ZIPF), lruZipf);
+  BOOST_CHECK_GE(replay<s3_fifo_policy_traits>(ZIPF), lruZipf);
+
+  // and much better with the scan, which flushes the LRU cache
+  BOOST_CHECK_GT(replay<arc_policy_traits>(ZIPF_SCAN), lruMixed + 0.05);
+  BOOST_CHECK_GT(replay<two_queue_policy_traits>(ZIPF_SCAN), lruMixed + 0.05);
+  BOOST_CHECK_GT(replay<s3_fifo_policy_traits>(ZIPF_SCAN), lruMixed + 0.05);
+}
+
+template<class PolicyTraits>
+static void
+checkEraseAndResize()
+{
+  typedef trie_with_policy<Name, pointer_payload_traits<int>, PolicyTraits> Cache;
+
+  static int payload = 0;
+  Cache cache;
+  cache.getPolicy().set_max_size(10);
+
+  for (uint64_t i = 0; i < 10; i++) {
+    cache.insert(Name("/prefix").appendNumber(i), &payload);
+  }
+  BOOST_CHECK_EQUAL(cache.getPolicy().size(), 10);
+
+  // entries removed outside the policy (e.g., expired) must not leave the policy inconsistent
+  cache.erase(cache.find_exact(Name("/prefix").appendNumber(3)));
+  cache.erase(cache.find_exact(Name("/prefix").appendNumber(7)));
+  BOOST_CHECK_EQUAL(cache.getPolicy().size(), 8);
+
+  for (uint64_t i = 10; i < 30; i++) {
+    cache.insert(Name("/prefix").appendNumber(i), &payload);
+  }
+  BOOST_CHECK_EQUAL(cache.getPolicy().size(), 10);
+
+  // after max size is reduced, the next insert needs more than one eviction
+  cache.getPolicy().set_max_size(5);
+  cache.insert(Name("/prefix").appendNumber(100), &payload);
+  BOOST_CHECK_LE(cache.getPolicy().size(), 5);
+  BOOST_CHECK(cache.find_exact(Name("/prefix").appendNumber(100)) != cache.end());
+
+  size_t nEntries = 0;
+  for (uint64_t i = 0; i <= 100; i++) {
+    if (cache.find_exact(Name("/prefix").appendNumber(i)) != cache.end())
+      nEntries++;
+  }
+  BOOST_CHECK_EQUAL(nEntries, cache.getPolicy().size());
+
+  for (uint64_t i = 200; i < 220; i++) {
+    cache.insert(Name("/prefix").appendNumber(i), &payload);
+    BOOST_CHECK_LE(cache.getPolicy().size(), 5);
+  }
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.getPolicy().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EraseAndResize)
+{
+  checkEraseAndResize<arc_policy_traits>();
+  checkEraseAndResize<two_queue_policy_traits>();
+  checkEraseAndResize<s3_fifo_policy_traits>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-event-accounting.hpp"
+#include "ndn-mem-accounting.hpp"
+
+#include "ns3/log.h"
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.EventAccounting");
+
+namespace ns3 {
+namespace ndn {
+
+bool EventAccounting::g_isEnabled = false;
+
+namespace {
+
+std::array<EventAccounting::Counters, EventAccounting::N_SOURCES> g_counters;
+
+// state at the previous output, to calculate rates over the interval
+std::array<uint64_t, EventAccounting::N_SOURCES> g_lastScheduled;
+uint64_t g_lastEventCount = 0;
+Time g_lastTime;
+std::chrono::steady_clock::time_point g_installTime;
+std::chrono::steady_clock::time_point g_lastWallTime;
+
+shared_ptr<std::ostream> g_os;
+EventId g_printEvent;
+
+/**
+ * @brief Event that counts execution or discarding of the wrapped event
+ */
+class AccountedEvent : public EventImpl {
+public:
+  AccountedEvent(EventAccounting::Source source, EventImpl* event)
+    : m_source(source)
+    , m_event(event, false)
+    , m_isExecuted(false)
+  {
+  }
+
+  ~AccountedEvent()
+  {
+    if (!m_isExecuted) {
+      g_counters[m_source].nDiscarded++;
+    }
+  }
+
+protected:
+  void
+  Notify() override
+  {
+    m_isExecuted = true;
+    g_counters[m_source].nExecuted++;
+
+    MemAccounting::Scope scope(GetSubsystem(m_source));
+    m_event->Invoke();
+  }
+
+private:
+  static MemAccounting::Subsystem
+  GetSubsystem(EventAccounting::Source source)
+  {
+    switch (source) {
+    case EventAccounting::TRACER:
+      return MemAccounting::TRACER;
+    case EventAccounting::CS_CLEANING:
+    case EventAccounting::CS_STATS:
+      return MemAccounting::CS;
+    default:
+      return MemAccounting::APP;
+    }
+  }
+
+  EventAccounting::Source m_source;
+  Ptr<EventImpl> m_event;
+  bool m_isExecuted;
+};
+
+} // namespace
+
+void
+EventAccounting::Install(const std::string& file, Time interval /* = Seconds(1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Accounting disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  *outputStream << "Time\tWallTime\tEventRate\tSpeedRatio\tSource\tScheduled\tExecuted\tPending"
+                << "\tScheduleRate\n";
+
+  Enable();
+
+  g_os = outputStream;
+  g_installTime = std::chrono::steady_clock::now();
+  g_lastWallTime = g_installTime;
+  g_lastTime = Simulator::Now();
+  g_lastEventCount = Simulator::GetEventCount();
+  for (size_t i = 0; i < N_SOURCES; i++) {
+    g_lastScheduled[i] = g_counters[i].nScheduled;
+  }
+
+  // not tagged, the output itself should not show up in the counters
+  g_printEvent.Cancel();
+  g_printEvent = Simulator::Schedule(interval, &EventAccounting::PeriodicPrinter, interval);
+  Simulator::ScheduleDestroy(&EventAccounting::Disable);
+}
+
+void
+EventAccounting::Enable()
+{
+  g_isEnabled = true;
+}
+
+void
+EventAccounting::Disable()
+{
+  g_isEnabled = false;
+
+  g_printEvent.Cancel();
+  g_os = nullptr;
+}
+
+void
+EventAccounting::Reset()
+{
+  for (size_t i = 0; i < N_SOURCES; i++) {
+    g_counters[i] = Counters{0, 0, 0};
+    g_lastScheduled[i] = 0;
+  }
+}
+
+const EventAccounting::Counters&
+EventAccounting::GetCounters(Source source)
+{
+  return g_counters[source];
+}
+
+const char*
+EventAccounting::GetSourceName(Source source)
+{
+  switch (source) {
+  case APP_DELIVERY:
+    return "app-delivery";
+  case APP_SEND:
+    return "app-send";
+  case RETX_TIMER:
+    return "retx-timer";
+  case TRACER:
+    return "tracer";
+  case CS_CLEANING:
+    return "cs-cleaning";
+  case CS_STATS:
+    return "cs-stats";
+  case N_SOURCES:
+    break;
+  }
+  return "unknown";
+}
+
+Ptr<EventImpl>
+EventAccounting::Account(Source source, EventImpl* event)
+{
+  g_counters[source].nScheduled++;
+  return Ptr<EventImpl>(new AccountedEvent(source, event), false);
+}
+
+void
+EventAccounting::PeriodicPrinter(Time interval)
+{
+  PrintCounters(*g_os);
+  g_os->flush(); // so that the progress can be watched while simulation runs
+
+  g_printEvent = Simulator::Schedule(interval, &EventAccounting::PeriodicPrinter, interval);
+}
+
+void
+EventAccounting::PrintCounters(std::ostream& os)
+{
+  auto wallTime = std::chrono::steady_clock::now();
+  double wallSeconds = std::chrono::duration<double>(wallTime - g_lastWallTime).count();
+  double simSeconds = (Simulator::Now() - g_lastTime).ToDouble(Time::S);
+  uint64_t nEvents = Simulator::GetEventCount() - g_lastEventCount;
+
+  double eventRate = wallSeconds > 0 ? nEvents / wallSeconds : 0.0;
+  double speedRatio = wallSeconds > 0 ? simSeconds / wallSeconds : 0.0;
+
+  NS_LOG_INFO(eventRate << " events/s, " << speedRatio << " simulation seconds per second");
+
+  for (size_t i = 0; i < N_SOURCES; i++) {
+    const Counters& counters = g_counters[i];
+    if (counters.nScheduled == 0)
+      continue;
+
+    double scheduleRate = simSeconds > 0 ? (counters.nScheduled - g_lastScheduled[i]) / simSeconds
+                                         : 0.0;
+    os << Simulator::Now().ToDouble(Time::S) << "\t"
+       << std::chrono::duration<double>(wallTime - g_installTime).count() << "\t"
+       << eventRate << "\t" << speedRatio << "\t" << GetSourceName(static_cast<Source>(i)) << "\t"
+       << counters.nScheduled << "\t" << counters.nExecuted << "\t" << counters.GetPending() << "\t"
+       << scheduleRate << "\n";
+
+    g_lastScheduled[i] = counters.nScheduled;
+  }
+
+  g_lastWallTime = wallTime;
+  g_lastTime = Simulator::Now();
+  g_lastEventCount = Simulator::GetEventCount();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_EVENT_ACCOUNTING_HPP
+#define NDN_EVENT_ACCOUNTING_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/event-id.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simulator.h"
+
+#include <iosfwd>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Accounting of simulator events scheduled by ndnSIM components
+ *
+ * Components schedule their events through EventAccounting::Schedule/ScheduleNow, which tag the
+ * events with their source when accounting is enabled (and is a plain Simulator::Schedule
+ * otherwise).  For every source, the number of scheduled, executed, and discarded (cancelled or
+ * removed) events is counted; the difference is the number of the source's events pending in
+ * the simulator queue.
+ *
+ * Install writes these counters periodically, together with the simulator event rate and the
+ * ratio of simulation time to wall-clock time, to a file that can be watched while the
+ * simulation runs.
+ */
+class EventAccounting {
+public:
+  enum Source {
+    APP_DELIVERY, ///< delivery of packets from application faces to applications
+    APP_SEND,     ///< applications' scheduling of packet transmissions
+    RETX_TIMER,   ///< Consumer::CheckRetxTimeout polling
+    TRACER,       ///< periodic output of tracers (TracerSampler)
+    CS_CLEANING,  ///< removal of expired entries from content store with freshness
+    CS_STATS,     ///< emission of content store statistics
+    N_SOURCES
+  };
+
+  struct Counters {
+    uint64_t nScheduled;
+    uint64_t nExecuted;
+    uint64_t nDiscarded;
+
+    uint64_t
+    GetPending() const
+    {
+      // events scheduled before Reset may be executed or discarded after it
+      return nScheduled > nExecuted + nDiscarded ? nScheduled - nExecuted - nDiscarded : 0;
+    }
+  };
+
+  /**
+   * @brief Enable accounting and write counters into @p file every @p interval
+   *
+   * @param file File to which counters will be written.  If filename is -, then std::out is used
+   * @param interval How often counters will be written
+   *
+   * The output is tab-separated with columns: Time, WallTime (seconds since Install),
+   * EventRate (all simulator events per wall-clock second during the interval), SpeedRatio
+   * (simulation seconds per wall-clock second during the interval), Source, Scheduled, Executed,
+   * Pending, and ScheduleRate (events scheduled per simulation second during the interval).
+   * Counts are cumulative, a row is written for every source that has scheduled events.
+   */
+  static void
+  Install(const std::string& file, Time interval = Seconds(1.0));
+
+  static void
+  Enable();
+
+  static void
+  Disable();
+
+  static bool
+  IsEnabled()
+  {
+    return g_isEnabled;
+  }
+
+  /**
+   * @brief Reset counters (pending events are still accounted when they are executed)
+   */
+  static void
+  Reset();
+
+  static const Counters&
+  GetCounters(Source source);
+
+  static const char*
+  GetSourceName(Source source);
+
+  /**
+   * @brief Schedule event from @p source, arguments are the same as for Simulator::Schedule
+   */
+  template<typename... Args>
+  static EventId
+  Schedule(Source source, const Time& delay, Args... args)
+  {
+    if (!g_isEnabled) {
+      return Simulator::Schedule(delay, args...);
+    }
+    return Simulator::Schedule(delay, Account(source, MakeEvent(args...)));
+  }
+
+  /**
+   * @brief Schedule event from @p source, arguments are the same as for Simulator::ScheduleNow
+   */
+  template<typename... Args>
+  static EventId
+  ScheduleNow(Source source, Args... args)
+  {
+    if (!g_isEnabled) {
+      return Simulator::ScheduleNow(args...);
+    }
+    return Simulator::ScheduleNow(Account(source, MakeEvent(args...)));
+  }
+
+private:
+  static Ptr<EventImpl>
+  Account(Source source, EventImpl* event);
+
+  static void
+  PeriodicPrinter(Time interval);
+
+  static void
+  PrintCounters(std::ostream& os);
+
+private:
+  static bool g_isEnabled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_EVENT_ACCOUNTING_HPP
@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-forwarding-profiler.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("ndn.ForwardingProfiler");
+
+namespace ns3 {
+namespace ndn {
+
+bool ForwardingProfiler::g_isEnabled = false;
+
+namespace {
+
+/**
+ * @brief Stage on a call path
+ */
+struct Frame {
+  uint32_t node;
+  ForwardingProfiler::Stage stage; ///< N_STAGES for the root frame of a node
+  size_t parent;
+  std::array<size_t, ForwardingProfiler::N_STAGES> children; ///< 0 if there is no child
+  uint64_t nCalls;
+  uint64_t ticks;
+};
+
+// frame 0 is a placeholder, so that 0 can denote absence of a frame
+std::vector<Frame> g_frames(1);
+std::vector<size_t> g_roots; ///< @brief root frame of each node, indexed by node ID
+std::vector<std::pair<size_t, uint64_t>> g_stack; ///< @brief entered frames and start ticks
+
+uint64_t g_calibrationTicks = 0;
+std::chrono::steady_clock::time_point g_calibrationTime;
+
+inline uint64_t
+ReadTimer()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Get number of timer ticks per nanosecond, measured since the profiler was enabled
+ */
+double
+GetTicksPerNs()
+{
+  uint64_t ticks = ReadTimer() - g_calibrationTicks;
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                                                                 - g_calibrationTime).count();
+  if (ns <= 0 || ticks == 0)
+    return 1.0;
+  return static_cast<double>(ticks) / ns;
+}
+
+size_t
+GetChild(size_t parent, uint32_t node, ForwardingProfiler::Stage stage)
+{
+  size_t child = stage == ForwardingProfiler::N_STAGES ? 0 : g_frames[parent].children[stage];
+  if (child != 0)
+    return child;
+
+  Frame frame;
+  frame.node = node;
+  frame.stage = stage;
+  frame.parent = parent;
+  frame.children.fill(0);
+  frame.nCalls = 0;
+  frame.ticks = 0;
+
+  child = g_frames.size();
+  g_frames.push_back(frame);
+  if (stage != ForwardingProfiler::N_STAGES) {
+    g_frames[parent].children[stage] = child;
+  }
+  return child;
+}
+
+size_t
+GetRoot(uint32_t node)
+{
+  if (node >= g_roots.size()) {
+    g_roots.resize(node + 1, 0);
+  }
+  if (g_roots[node] == 0) {
+    g_roots[node] = GetChild(0, node, ForwardingProfiler::N_STAGES);
+  }
+  return g_roots[node];
+}
+
+uint64_t
+GetSelfTicks(const Frame& frame)
+{
+  uint64_t ticks = frame.ticks;
+  for (size_t child : frame.children) {
+    if (child != 0) {
+      ticks -= std::min(ticks, g_frames[child].ticks);
+    }
+  }
+  return ticks;
+}
+
+} // namespace
+
+void
+ForwardingProfiler::Install(const std::string& tableFile, const std::string& foldedFile)
+{
+  Enable();
+  Simulator::ScheduleDestroy(&ForwardingProfiler::WriteReport, tableFile, foldedFile);
+}
+
+void
+ForwardingProfiler::Enable()
+{
+  if (g_calibrationTicks == 0) {
+    g_calibrationTicks = ReadTimer();
+    g_calibrationTime = std::chrono::steady_clock::now();
+  }
+  g_isEnabled = true;
+}
+
+void
+ForwardingProfiler::Disable()
+{
+  g_isEnabled = false;
+}
+
+void
+ForwardingProfiler::Reset()
+{
+  g_frames.resize(1);
+  g_roots.clear();
+  g_stack.clear();
+}
+
+bool
+ForwardingProfiler::Enter(uint32_t node, Stage stage)
+{
+  if (!g_isEnabled)
+    return false;
+
+  size_t parent = 0;
+  if (!g_stack.empty() && g_frames[g_stack.back().first].node == node) {
+    parent = g_stack.back().first;
+  }
+  else {
+    parent = GetRoot(node);
+  }
+
+  size_t frame = GetChild(parent, node, stage);
+  g_stack.push_back(std::make_pair(frame, ReadTimer()));
+  return true;
+}
+
+bool
+ForwardingProfiler::Enter(Stage stage)
+{
+  if (!g_isEnabled || g_stack.empty())
+    return false;
+
+  size_t parent = g_stack.back().first;
+  size_t frame = GetChild(parent, g_frames[parent].node, stage);
+  g_stack.push_back(std::make_pair(frame, ReadTimer()));
+  return true;
+}
+
+void
+ForwardingProfiler::Leave(Stage stage)
+{
+  uint64_t now = ReadTimer();
+  if (g_stack.empty() || g_frames[g_stack.back().first].stage != stage)
+    return;
+
+  Frame& frame = g_frames[g_stack.back().first];
+  frame.nCalls++;
+  frame.ticks += now - g_stack.back().second;
+  g_stack.pop_back();
+}
+
+const char*
+ForwardingProfiler::GetStageName(Stage stage)
+{
+  switch (stage) {
+  case RECEIVE:
+    return "receive";
+  case DECODE:
+    return "decode";
+  case INCOMING_INTEREST:
+    return "incoming-interest";
+  case INCOMING_DATA:
+    return "incoming-data";
+  case INCOMING_NACK:
+    return "incoming-nack";
+  case CS_LOOKUP:
+    return "cs-lookup";
+  case CS_INSERT:
+    return "cs-insert";
+  case SEND:
+    return "send";
+  case ENCODE:
+    return "encode";
+  case TRACE:
+    return "trace";
+  case N_STAGES:
+    break;
+  }
+  return "unknown";
+}
+
+ForwardingProfiler::Stats
+ForwardingProfiler::GetStats(uint32_t node, Stage stage)
+{
+  // total time of a stage nested in itself (e.g., send within send) is counted once
+  double ticksPerNs = GetTicksPerNs();
+  Stats stats = {0, 0, 0};
+
+  for (size_t i = 1; i < g_frames.size(); i++) {
+    const Frame& frame = g_frames[i];
+    if (frame.node != node || frame.stage != stage)
+      continue;
+
+    bool isNested = false;
+    for (size_t parent = frame.parent; parent != 0; parent = g_frames[parent].parent) {
+      isNested = isNested || g_frames[parent].stage == stage;
+    }
+
+    stats.nCalls += frame.nCalls;
+    stats.selfNs += static_cast<uint64_t>(GetSelfTicks(frame) / ticksPerNs);
+    if (!isNested) {
+      stats.totalNs += static_cast<uint64_t>(frame.ticks / ticksPerNs);
+    }
+  }
+  return stats;
+}
+
+void
+ForwardingProfiler::PrintTable(std::ostream& os)
+{
+  std::vector<std::tuple<std::string, Stage, Stats>> rows;
+  std::array<Stats, N_STAGES> all;
+  all.fill(Stats{0, 0, 0});
+
+  for (uint32_t node = 0; node < g_roots.size(); node++) {
+    if (g_roots[node] == 0)
+      continue;
+
+    for (int stage = 0; stage < N_STAGES; stage++) {
+      Stats stats = GetStats(node, static_cast<Stage>(stage));
+      if (stats.nCalls == 0)
+        continue;
+
+      rows.push_back(std::make_tuple(std::to_string(node), static_cast<Stage>(stage), stats));
+      all[stage].nCalls += stats.nCalls;
+      all[stage].totalNs += stats.totalNs;
+      all[stage].selfNs += stats.selfNs;
+    }
+  }
+  for (int stage = 0; stage < N_STAGES; stage++) {
+    if (all[stage].nCalls != 0) {
+      rows.push_back(std::make_tuple("all", static_cast<Stage>(stage), all[stage]));
+    }
+  }
+
+  std::stable_sort(rows.begin(), rows.end(), [] (const std::tuple<std::string, Stage, Stats>& a,
+                                                 const std::tuple<std::string, Stage, Stats>& b) {
+      return std::get<2>(a).selfNs > std::get<2>(b).selfNs;
+    });
+
+  os << "Node\tStage\tCalls\tTotalUs\tSelfUs\tMeanNs\n";
+  for (const auto& row : rows) {
+    const Stats& stats = std::get<2>(row);
+    os << std::get<0>(row) << "\t" << GetStageName(std::get<1>(row)) << "\t" << stats.nCalls << "\t"
+       << stats.totalNs / 1000.0 << "\t" << stats.selfNs / 1000.0 << "\t"
+       << stats.totalNs / stats.nCalls << "\n";
+  }
+}
+
+void
+ForwardingProfiler::PrintFoldedStacks(std::ostream& os)
+{
+  double ticksPerNs = GetTicksPerNs();
+
+  for (size_t i = 1; i < g_frames.size(); i++) {
+    const Frame& frame = g_frames[i];
+    if (frame.stage == N_STAGES || frame.nCalls == 0)
+      continue;
+
+    std::vector<Stage> path;
+    size_t root = i;
+    for (; g_frames[root].stage != N_STAGES; root = g_frames[root].parent) {
+      path.push_back(g_frames[root].stage);
+    }
+
+    os << "node" << g_frames[root].node;
+    for (auto stage = path.rbegin(); stage != path.rend(); ++stage) {
+      os << ";" << GetStageName(*stage);
+    }
+    os << " " << static_cast<uint64_t>(GetSelfTicks(frame) / ticksPerNs) << "\n";
+  }
+}
+
+void
+ForwardingProfiler::WriteReport(const std::string& tableFile, const std::string& foldedFile)
+{
+  std::ofstream table(tableFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!table.is_open()) {
+    NS_LOG_ERROR("File " << tableFile << " cannot be opened for writing");
+  }
+  else {
+    PrintTable(table);
+  }
+
+  std::ofstream folded(foldedFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!folded.is_open()) {
+    NS_LOG_ERROR("File " << foldedFile << " cannot be opened for writing");
+  }
+  else {
+    PrintFoldedStacks(folded);
+  }
+
+  Disable();
+  Reset();
+}
+
+} // namespace ndn
+} // namespace ns3
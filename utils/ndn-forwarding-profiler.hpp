@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FORWARDING_PROFILER_HPP
+#define NDN_FORWARDING_PROFILER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <iosfwd>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Wall-clock profiler of the forwarding pipeline stages
+ *
+ * When enabled, NetDeviceTransport, L3Protocol, and ContentStoreImpl (ndnSIM content stores)
+ * measure how much real time every node spends in each stage, using the CPU time stamp counter
+ * where available.  Stages nest (e.g., CS lookup and send are part of an incoming Interest
+ * pipeline, which is part of a receive), and time is accounted separately for every call path.
+ * Time of a stage that is not covered by nested stages (self time) includes the remaining work
+ * of NFD: PIT, FIB, and strategy for incoming packets, link service for send and receive.
+ *
+ * The profiler must be enabled before the NDN stack is installed, as pipelines are measured
+ * only on faces created while the profiler is enabled.
+ */
+class ForwardingProfiler {
+public:
+  enum Stage {
+    RECEIVE,           ///< NetDeviceTransport receive, including all processing of the packet
+    DECODE,            ///< conversion of ns-3 packet into NDN packet
+    INCOMING_INTEREST, ///< forwarder incoming Interest pipeline
+    INCOMING_DATA,     ///< forwarder incoming Data pipeline
+    INCOMING_NACK,     ///< forwarder incoming Nack pipeline
+    CS_LOOKUP,         ///< ndnSIM content store lookup
+    CS_INSERT,         ///< ndnSIM content store insertion
+    SEND,              ///< NetDeviceTransport send, including NetDevice
+    ENCODE,            ///< conversion of NDN packet into ns-3 packet(s)
+    TRACE,             ///< L3Protocol trace sources (i.e., connected tracers)
+    N_STAGES
+  };
+
+  struct Stats {
+    uint64_t nCalls;
+    uint64_t totalNs; ///< @brief time in the stage, including nested stages
+    uint64_t selfNs;  ///< @brief time in the stage, excluding nested stages
+  };
+
+  /**
+   * @brief Measures the stage for the lifetime of the object
+   */
+  class Scope : boost::noncopyable {
+  public:
+    Scope(uint32_t node, Stage stage)
+      : m_stage(stage)
+      , m_isEntered(g_isEnabled && Enter(node, stage))
+    {
+    }
+
+    /**
+     * @brief Measure the stage as a part of the enclosing stage (and of the same node)
+     */
+    explicit Scope(Stage stage)
+      : m_stage(stage)
+      , m_isEntered(g_isEnabled && Enter(stage))
+    {
+    }
+
+    ~Scope()
+    {
+      if (m_isEntered) {
+        Leave(m_stage);
+      }
+    }
+
+  private:
+    Stage m_stage;
+    bool m_isEntered;
+  };
+
+  /**
+   * @brief Enable profiler, writing report into @p tableFile and @p foldedFile when the
+   *        simulator is destroyed
+   *
+   * @see PrintTable, PrintFoldedStacks
+   */
+  static void
+  Install(const std::string& tableFile, const std::string& foldedFile);
+
+  static void
+  Enable();
+
+  static void
+  Disable();
+
+  static bool
+  IsEnabled()
+  {
+    return g_isEnabled;
+  }
+
+  /**
+   * @brief Discard all measurements
+   */
+  static void
+  Reset();
+
+  /**
+   * @brief Start measuring @p stage of @p node
+   * @returns false if profiler is disabled
+   */
+  static bool
+  Enter(uint32_t node, Stage stage);
+
+  /**
+   * @brief Start measuring @p stage as a part of the enclosing stage
+   * @returns false if profiler is disabled or there is no enclosing stage
+   */
+  static bool
+  Enter(Stage stage);
+
+  /**
+   * @brief Stop measuring the innermost stage, if it is @p stage
+   */
+  static void
+  Leave(Stage stage);
+
+  /**
+   * @brief Get measurements of @p stage on @p node, summed over all call paths
+   */
+  static Stats
+  GetStats(uint32_t node, Stage stage);
+
+  static const char*
+  GetStageName(Stage stage);
+
+  /**
+   * @brief Print tab-separated table (Node, Stage, Calls, TotalUs, SelfUs, MeanNs) with a row
+   *        per node and stage, and per stage for all nodes (Node is "all"), sorted by self time
+   */
+  static void
+  PrintTable(std::ostream& os);
+
+  /**
+   * @brief Print self time (in nanoseconds) of every call path in folded stack format, which
+   *        can be rendered using flamegraph.pl
+   *
+   * Example line: "node3;receive;incoming-interest;cs-lookup 12345"
+   */
+  static void
+  PrintFoldedStacks(std::ostream& os);
+
+private:
+  static void
+  WriteReport(const std::string& tableFile, const std::string& foldedFile);
+
+private:
+  static bool g_isEnabled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FORWARDING_PROFILER_HPP
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "ndn-hdr-histogram.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+// number of exactly counted values and number of buckets per power of two above them
+static const uint64_t N_EXACT = static_cast<uint64_t>(1) << HdrHistogram::SUB_BUCKET_BITS;
+static const uint64_t N_SUB_BUCKETS = N_EXACT / 2;
+
+HdrHistogram::HdrHistogram()
+{
+  Reset();
+}
+
+size_t
+HdrHistogram::GetBucket(uint64_t value)
+{
+  if (value < N_EXACT)
+    return value;
+
+  unsigned msb = 63 - __builtin_clzll(value);
+  unsigned shift = msb - SUB_BUCKET_BITS + 1;
+  uint64_t top = value >> shift; // in [N_SUB_BUCKETS, N_EXACT)
+  return N_EXACT + (shift - 1) * N_SUB_BUCKETS + (top - N_SUB_BUCKETS);
+}
+
+uint64_t
+HdrHistogram::GetBucketLowerBound(size_t bucket)
+{
+  if (bucket < N_EXACT)
+    return bucket;
+
+  uint64_t shift = (bucket - N_EXACT) / N_SUB_BUCKETS + 1;
+  uint64_t top = (bucket - N_EXACT) % N_SUB_BUCKETS + N_SUB_BUCKETS;
+  return top << shift;
+}
+
+uint64_t
+HdrHistogram::GetBucketUpperBound(size_t bucket)
+{
+  if (bucket < N_EXACT)
+    return bucket;
+
+  uint64_t shift = (bucket - N_EXACT) / N_SUB_BUCKETS + 1;
+  return GetBucketLowerBound(bucket) + ((static_cast<uint64_t>(1) << shift) - 1);
+}
+
+void
+HdrHistogram::Add(uint64_t value, uint64_t count)
+{
+  size_t bucket = GetBucket(value);
+  if (bucket >= m_counts.size()) {
+    m_counts.resize(bucket + 1, 0);
+  }
+
+  m_counts[bucket] += count;
+  m_total += count;
+  m_sum += value * count;
+  m_max = std::max(m_max, value);
+}
+
+void
+HdrHistogram::Merge(const HdrHistogram& other)
+{
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size(), 0);
+  }
+
+  for (size_t i = 0; i < other.m_counts.size(); i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_total += other.m_total;
+  m_sum += other.m_sum;
+  m_max = std::max(m_max, other.m_max);
+}
+
+void
+HdrHistogram::Reset()
+{
+  // keep allocated buckets, histograms are usually reset every interval
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_total = 0;
+  m_sum = 0;
+  m_max = 0;
+}
+
+uint64_t
+HdrHistogram::GetQuantile(double quantile) const
+{
+  if (m_total == 0)
+    return 0;
+
+  double rank = quantile * m_total;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    seen += m_counts[i];
+    if (seen > 0 && seen >= rank)
+      return std::min(GetBucketUpperBound(i), m_max);
+  }
+  return m_max;
+}
+
+void
+HdrHistogram::Print(std::ostream& os) const
+{
+  bool isFirst = true;
+  for (size_t i = 0; i < m_counts.size(); i++) {
+    if (m_counts[i] == 0)
+      continue;
+
+    if (!isFirst)
+      os << " ";
+    os << GetBucketLowerBound(i) << ":" << m_counts[i];
+    isFirst = false;
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const HdrHistogram& histogram)
+{
+  histogram.Print(os);
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
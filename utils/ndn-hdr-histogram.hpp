@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#ifndef NDNSIM_UTILS_HDR_HISTOGRAM_HPP
+#define NDNSIM_UTILS_HDR_HISTOGRAM_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief High dynamic range histogram with bounded relative error
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly; larger values fall into buckets whose
+ * width is at most 1/2^(SUB_BUCKET_BITS-1) (< 1%) of the value.  Buckets are allocated up to the
+ * largest added value, so a histogram of delays in microseconds takes a few kilobytes.
+ *
+ * Histograms are mergeable: merging histograms of several applications or nodes (or intervals)
+ * gives the same quantiles as recording all values into one histogram.
+ */
+class HdrHistogram {
+public:
+  static const unsigned SUB_BUCKET_BITS = 8;
+
+  HdrHistogram();
+
+  void
+  Add(uint64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add counts of another histogram
+   */
+  void
+  Merge(const HdrHistogram& other);
+
+  void
+  Reset();
+
+  /**
+   * @brief Get number of the bucket for @p value
+   */
+  static size_t
+  GetBucket(uint64_t value);
+
+  /**
+   * @brief Get the smallest value that falls into the bucket
+   */
+  static uint64_t
+  GetBucketLowerBound(size_t bucket);
+
+  /**
+   * @brief Get the largest value that falls into the bucket
+   */
+  static uint64_t
+  GetBucketUpperBound(size_t bucket);
+
+  /**
+   * @brief Get total number of added values
+   */
+  uint64_t
+  GetTotal() const
+  {
+    return m_total;
+  }
+
+  /**
+   * @brief Get sum of added values
+   */
+  uint64_t
+  GetSum() const
+  {
+    return m_sum;
+  }
+
+  double
+  GetMean() const
+  {
+    return m_total == 0 ? 0.0 : static_cast<double>(m_sum) / m_total;
+  }
+
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Get value at the @p quantile (0..1) of added values
+   *
+   * The value is the upper bound of the bucket that contains the quantile (but not larger than
+   * the maximum added value), i.e., it overestimates the exact quantile by less than 1%.
+   */
+  uint64_t
+  GetQuantile(double quantile) const;
+
+  /**
+   * @brief Print non-empty buckets as space separated "lower-bound:count" pairs
+   */
+  void
+  Print(std::ostream& os) const;
+
+private:
+  std::vector<uint64_t> m_counts;
+  uint64_t m_total;
+  uint64_t m_sum;
+  uint64_t m_max;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const HdrHistogram& histogram);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_HDR_HISTOGRAM_HPP
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-histogram.hpp"
+
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+LogHistogram::LogHistogram()
+{
+  Reset();
+}
+
+size_t
+LogHistogram::GetBucket(uint64_t value)
+{
+  size_t bucket = 0;
+  while (value != 0) {
+    value >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+uint64_t
+LogHistogram::GetBucketLowerBound(size_t bucket)
+{
+  return bucket == 0 ? 0 : (static_cast<uint64_t>(1) << (bucket - 1));
+}
+
+void
+LogHistogram::Add(uint64_t value, uint64_t count)
+{
+  m_counts[GetBucket(value)] += count;
+  m_total += count;
+  m_sum += value * count;
+}
+
+void
+LogHistogram::Merge(const LogHistogram& other)
+{
+  for (size_t i = 0; i < N_BUCKETS; i++) {
+    m_counts[i] += other.m_counts[i];
+  }
+  m_total += other.m_total;
+  m_sum += other.m_sum;
+}
+
+void
+LogHistogram::Reset()
+{
+  m_counts.fill(0);
+  m_total = 0;
+  m_sum = 0;
+}
+
+uint64_t
+LogHistogram::GetQuantile(double quantile) const
+{
+  if (m_total == 0)
+    return 0;
+
+  double rank = quantile * m_total;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; i++) {
+    seen += m_counts[i];
+    if (seen > 0 && seen >= rank)
+      return GetBucketLowerBound(i);
+  }
+  return GetBucketLowerBound(N_BUCKETS - 1);
+}
+
+void
+LogHistogram::Print(std::ostream& os) const
+{
+  bool isFirst = true;
+  for (size_t i = 0; i < N_BUCKETS; i++) {
+    if (m_counts[i] == 0)
+      continue;
+
+    if (!isFirst)
+      os << " ";
+    os << GetBucketLowerBound(i) << ":" << m_counts[i];
+    isFirst = false;
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LogHistogram& histogram)
+{
+  histogram.Print(os);
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
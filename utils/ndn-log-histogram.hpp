@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_LOG_HISTOGRAM_HPP
+#define NDNSIM_UTILS_LOG_HISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Histogram with logarithmic (power of two) buckets
+ *
+ * Bucket 0 counts zero values, bucket i (i > 0) counts values in [2^(i-1), 2^i).  Adding a
+ * value costs a couple of instructions and the histogram has a fixed size, so it can be
+ * updated on every cache operation.
+ */
+class LogHistogram {
+public:
+  static const size_t N_BUCKETS = 65;
+
+  LogHistogram();
+
+  void
+  Add(uint64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add counts of another histogram
+   */
+  void
+  Merge(const LogHistogram& other);
+
+  void
+  Reset();
+
+  /**
+   * @brief Get number of the bucket for @p value
+   */
+  static size_t
+  GetBucket(uint64_t value);
+
+  /**
+   * @brief Get the smallest value that falls into the bucket
+   */
+  static uint64_t
+  GetBucketLowerBound(size_t bucket);
+
+  uint64_t
+  GetCount(size_t bucket) const
+  {
+    return m_counts[bucket];
+  }
+
+  /**
+   * @brief Get total number of added values
+   */
+  uint64_t
+  GetTotal() const
+  {
+    return m_total;
+  }
+
+  /**
+   * @brief Get sum of added values
+   */
+  uint64_t
+  GetSum() const
+  {
+    return m_sum;
+  }
+
+  /**
+   * @brief Get lower bound of the bucket that contains the @p quantile (0..1) of added values
+   */
+  uint64_t
+  GetQuantile(double quantile) const;
+
+  /**
+   * @brief Print non-empty buckets as space separated "lower-bound:count" pairs
+   */
+  void
+  Print(std::ostream& os) const;
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_counts;
+  uint64_t m_total;
+  uint64_t m_sum;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LogHistogram& histogram);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_LOG_HISTOGRAM_HPP
@@ -0,0 +1,456 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mem-accounting.hpp"
+#include "ndn-event-accounting.hpp"
+#include "tracers/ndn-tracer-sampler.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemAccounting");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Attribution stored in front of every counted allocation
+ */
+struct alignas(16) Header {
+  uint64_t size;
+  uint32_t node;
+  uint16_t subsystem;
+  uint16_t generation; ///< @brief counters the allocation was added to
+};
+
+static_assert(sizeof(Header) == 16, "Header must keep the default alignment of allocations");
+
+struct State {
+  uint32_t node;
+  MemAccounting::Subsystem subsystem;
+};
+
+// scopes of the current thread; plain data, as it is used by operator new
+const int MAX_DEPTH = 64;
+thread_local State t_scopes[MAX_DEPTH];
+thread_local int t_depth = 0;
+
+// counters of node N are at (N + 1) * N_SUBSYSTEMS + subsystem (index 0 is NO_NODE), grown
+// using realloc, as operator new cannot be used here
+MemAccounting::Counters* g_counters = nullptr;
+size_t g_nCounters = 0;
+std::atomic_flag g_lock = ATOMIC_FLAG_INIT; // trace writer threads allocate too
+
+// counters are reset when the simulation is destroyed, so that node IDs reused by the next
+// simulation start from zero; allocations that outlive the reset are not subtracted afterwards
+uint16_t g_generation = 0;
+
+bool g_isEnabled = false;
+shared_ptr<std::ostream> g_os;
+TracerSampler::Id g_sampler = TracerSampler::INVALID_ID;
+
+size_t
+GetIndex(uint32_t node, uint32_t subsystem)
+{
+  return (node == MemAccounting::NO_NODE ? 0 : static_cast<size_t>(node) + 1)
+           * MemAccounting::N_SUBSYSTEMS + subsystem;
+}
+
+void
+Account(Header& header, bool isAllocated)
+{
+  size_t index = GetIndex(header.node, header.subsystem);
+
+  while (g_lock.test_and_set(std::memory_order_acquire))
+    ;
+
+  if (isAllocated) {
+    header.generation = g_generation;
+  }
+  else if (header.generation != g_generation) {
+    g_lock.clear(std::memory_order_release);
+    return;
+  }
+
+  if (index >= g_nCounters) {
+    size_t size = std::max(index + 1, 2 * g_nCounters);
+    auto counters = static_cast<MemAccounting::Counters*>(std::realloc(g_counters, size * sizeof(
+                                                                         MemAccounting::Counters)));
+    if (counters != nullptr) {
+      std::fill(counters + g_nCounters, counters + size, MemAccounting::Counters{0, 0});
+      g_counters = counters;
+      g_nCounters = size;
+    }
+  }
+
+  if (index < g_nCounters) {
+    int64_t sign = isAllocated ? 1 : -1;
+    g_counters[index].nBytes += sign * static_cast<int64_t>(header.size);
+    g_counters[index].nAllocations += sign;
+  }
+
+  g_lock.clear(std::memory_order_release);
+}
+
+void
+ResetCounters()
+{
+  while (g_lock.test_and_set(std::memory_order_acquire))
+    ;
+  std::fill(g_counters, g_counters + g_nCounters, MemAccounting::Counters{0, 0});
+  g_generation++;
+  g_lock.clear(std::memory_order_release);
+}
+
+const State&
+GetCurrentState()
+{
+  static const State none = {MemAccounting::NO_NODE, MemAccounting::OTHER};
+  if (t_depth == 0)
+    return none;
+  return t_scopes[std::min(t_depth, MAX_DEPTH) - 1];
+}
+
+void
+Clear()
+{
+  g_isEnabled = false;
+  g_os = nullptr;
+  g_sampler = TracerSampler::INVALID_ID;
+  ResetCounters();
+}
+
+} // namespace
+
+void
+MemAccounting::Install(const std::string& file, Time interval /* = Seconds(1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Accounting disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  if (!IsCounting()) {
+    NS_LOG_WARN("ndnSIM is built without --enable-mem-accounting, only table entries are reported");
+  }
+
+  *outputStream << "Time\tNode\tSubsystem\tEntries\tBytes\tAllocations\n";
+
+  Enable();
+  g_os = outputStream;
+
+  TracerSampler::Unregister(g_sampler);
+  g_sampler = TracerSampler::Register(interval, g_os, &MemAccounting::PrintRecords);
+}
+
+void
+MemAccounting::Enable()
+{
+  if (g_isEnabled)
+    return;
+
+  g_isEnabled = true;
+
+  // events of applications, tracers, and content stores are attributed by their source
+  EventAccounting::Enable();
+  Simulator::ScheduleDestroy(&EventAccounting::Disable);
+  Simulator::ScheduleDestroy(&Clear);
+}
+
+bool
+MemAccounting::IsEnabled()
+{
+  return g_isEnabled;
+}
+
+bool
+MemAccounting::IsCounting()
+{
+#ifdef NDNSIM_MEM_ACCOUNTING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+MemAccounting::Enter(Subsystem subsystem, uint32_t node /* = CURRENT_NODE*/)
+{
+  if (node == CURRENT_NODE) {
+    node = t_depth > 0 ? GetCurrentState().node : Simulator::GetContext();
+  }
+
+  if (t_depth < MAX_DEPTH) {
+    t_scopes[t_depth].node = node;
+    t_scopes[t_depth].subsystem = subsystem;
+  }
+  t_depth++;
+}
+
+void
+MemAccounting::Leave()
+{
+  if (t_depth > 0) {
+    t_depth--;
+  }
+}
+
+MemAccounting::Subsystem
+MemAccounting::GetCurrentSubsystem()
+{
+  return GetCurrentState().subsystem;
+}
+
+uint32_t
+MemAccounting::GetCurrentNode()
+{
+  return GetCurrentState().node;
+}
+
+MemAccounting::Counters
+MemAccounting::GetCounters(uint32_t node, Subsystem subsystem)
+{
+  Counters counters = {0, 0};
+  size_t index = GetIndex(node, subsystem);
+
+  while (g_lock.test_and_set(std::memory_order_acquire))
+    ;
+  if (index < g_nCounters) {
+    counters = g_counters[index];
+  }
+  g_lock.clear(std::memory_order_release);
+
+  return counters;
+}
+
+int64_t
+MemAccounting::GetEntries(uint32_t node, Subsystem subsystem)
+{
+  if (node >= NodeList::GetNNodes())
+    return -1;
+
+  Ptr<Node> nodePtr = NodeList::GetNode(node);
+  if (subsystem == APP)
+    return nodePtr->GetNApplications();
+
+  Ptr<L3Protocol> ndn = nodePtr->GetObject<L3Protocol>();
+  if (ndn == nullptr)
+    return -1;
+
+  shared_ptr<nfd::Forwarder> forwarder = ndn->getForwarder();
+  switch (subsystem) {
+  case PIT:
+    return forwarder->getPit().size();
+  case FIB:
+    return forwarder->getFib().size();
+  case FACE:
+    return forwarder->getFaceTable().size();
+  case CS: {
+    Ptr<ContentStore> cs = nodePtr->GetObject<ContentStore>();
+    if (cs != nullptr)
+      return cs->GetSize();
+    return forwarder->getCs().size();
+  }
+  default:
+    return -1;
+  }
+}
+
+const char*
+MemAccounting::GetSubsystemName(Subsystem subsystem)
+{
+  switch (subsystem) {
+  case OTHER:
+    return "OTHER";
+  case PIT:
+    return "PIT";
+  case CS:
+    return "CS";
+  case FIB:
+    return "FIB";
+  case FACE:
+    return "FACE";
+  case APP:
+    return "APP";
+  case TRACER:
+    return "TRACER";
+  case N_SUBSYSTEMS:
+    break;
+  }
+  return "unknown";
+}
+
+void*
+MemAccounting::Allocate(std::size_t size) noexcept
+{
+  Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+  if (header == nullptr)
+    return nullptr;
+
+  const State& state = GetCurrentState();
+  header->size = size;
+  header->node = state.node;
+  header->subsystem = static_cast<uint16_t>(state.subsystem);
+  Account(*header, true);
+
+  return header + 1;
+}
+
+void
+MemAccounting::Deallocate(void* ptr) noexcept
+{
+  if (ptr == nullptr)
+    return;
+
+  Header* header = static_cast<Header*>(ptr) - 1;
+  Account(*header, false);
+  std::free(header);
+}
+
+void
+MemAccounting::PrintRecords(std::ostream& os)
+{
+  double now = Simulator::Now().ToDouble(Time::S);
+
+  for (uint32_t node = 0; node <= NodeList::GetNNodes(); node++) {
+    // memory not attributed to any node goes last
+    uint32_t id = node < NodeList::GetNNodes() ? node : NO_NODE;
+
+    for (int subsystem = 0; subsystem < N_SUBSYSTEMS; subsystem++) {
+      int64_t entries = GetEntries(id, static_cast<Subsystem>(subsystem));
+      Counters counters = GetCounters(id, static_cast<Subsystem>(subsystem));
+      if (entries <= 0 && counters.nAllocations == 0)
+        continue;
+
+      os << now << "\t";
+      if (id == NO_NODE) {
+        os << "-";
+      }
+      else {
+        os << id;
+      }
+      os << "\t" << GetSubsystemName(static_cast<Subsystem>(subsystem)) << "\t";
+      if (entries < 0) {
+        os << "NA";
+      }
+      else {
+        os << entries;
+      }
+      os << "\t" << counters.nBytes << "\t" << counters.nAllocations << "\n";
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NDNSIM_MEM_ACCOUNTING
+
+void*
+operator new(std::size_t size)
+{
+  void* ptr = ns3::ndn::MemAccounting::Allocate(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void*
+operator new[](std::size_t size)
+{
+  void* ptr = ns3::ndn::MemAccounting::Allocate(size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return ns3::ndn::MemAccounting::Allocate(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return ns3::ndn::MemAccounting::Allocate(size);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  ns3::ndn::MemAccounting::Deallocate(ptr);
+}
+
+#endif // NDNSIM_MEM_ACCOUNTING
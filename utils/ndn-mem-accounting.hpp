@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MEM_ACCOUNTING_HPP
+#define NDN_MEM_ACCOUNTING_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Attribution of memory to ndnSIM subsystems of each node
+ *
+ * Code that creates long-lived state of a subsystem (e.g., forwarding pipelines creating PIT
+ * entries, or application helper creating applications) runs within a Scope that names the
+ * subsystem and the node.  When ndnSIM is configured with ``--enable-mem-accounting``, global
+ * operator new and delete are replaced to count live bytes and allocations of every scope;
+ * otherwise only the number of table entries (PIT, FIB, CS, faces, and applications) is reported.
+ *
+ * Allocations outside of any scope are attributed to OTHER subsystem and no node.  Scopes
+ * without an explicit node belong to the node of the enclosing scope or, for the outermost scope,
+ * to the node in whose context the current simulator event runs.
+ */
+class MemAccounting {
+public:
+  enum Subsystem {
+    OTHER,  ///< not attributed
+    PIT,    ///< incoming Interest and Nack pipelines (PIT, nonces, measurements)
+    CS,     ///< incoming Data pipeline and ndnSIM content stores
+    FIB,    ///< FIB updates by FibHelper and GlobalRoutingHelper
+    FACE,   ///< faces, link services, and transports
+    APP,    ///< applications
+    TRACER, ///< tracers and trace writers
+    N_SUBSYSTEMS
+  };
+
+  /**
+   * @brief Node of allocations not attributed to any node
+   */
+  static const uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Node of the enclosing scope, or of the current simulator context
+   */
+  static const uint32_t CURRENT_NODE = NO_NODE - 1;
+
+  struct Counters {
+    int64_t nBytes;
+    int64_t nAllocations;
+  };
+
+  /**
+   * @brief Attributes allocations to @p subsystem of @p node for the lifetime of the object
+   */
+  class Scope : boost::noncopyable {
+  public:
+    explicit
+    Scope(Subsystem subsystem, uint32_t node = CURRENT_NODE)
+    {
+      Enter(subsystem, node);
+    }
+
+    ~Scope()
+    {
+      Leave();
+    }
+  };
+
+  /**
+   * @brief Write memory of every node and subsystem into @p file every @p interval
+   *
+   * @param file File to which records will be written.  If filename is -, then std::out is used
+   * @param interval How often records will be written
+   *
+   * The output is tab-separated with columns: Time, Node ("-" for memory not attributed to any
+   * node), Subsystem, Entries (number of table entries, NA for OTHER and TRACER), Bytes and
+   * Allocations (live bytes and allocations, zero unless built with --enable-mem-accounting).
+   */
+  static void
+  Install(const std::string& file, Time interval = Seconds(1.0));
+
+  /**
+   * @brief Attribute memory to subsystems and nodes without writing records
+   *
+   * Counters can then be read with GetCounters and GetEntries.  Like Install, attribution lasts
+   * until Simulator::Destroy, which also resets the counters.
+   */
+  static void
+  Enable();
+
+  /**
+   * @brief Check whether Install or Enable has been called
+   *
+   * Forwarding pipelines are attributed to PIT and CS only on faces created after Install or
+   * Enable.
+   */
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Check whether allocations are counted (ndnSIM built with --enable-mem-accounting)
+   */
+  static bool
+  IsCounting();
+
+  /**
+   * @brief Attribute subsequent allocations of the current thread to @p subsystem of @p node
+   */
+  static void
+  Enter(Subsystem subsystem, uint32_t node = CURRENT_NODE);
+
+  /**
+   * @brief Restore attribution of the enclosing scope
+   */
+  static void
+  Leave();
+
+  static Subsystem
+  GetCurrentSubsystem();
+
+  static uint32_t
+  GetCurrentNode();
+
+  /**
+   * @brief Get live bytes and allocations of @p subsystem on @p node
+   *
+   * After Install or Enable, counters are reset by Simulator::Destroy, so that consecutive
+   * simulations in one process do not see memory of the previous ones.  Memory allocated before
+   * the reset and freed afterwards is not subtracted.
+   */
+  static Counters
+  GetCounters(uint32_t node, Subsystem subsystem);
+
+  /**
+   * @brief Get number of table entries of @p subsystem on @p node, or -1 if not applicable
+   */
+  static int64_t
+  GetEntries(uint32_t node, Subsystem subsystem);
+
+  static const char*
+  GetSubsystemName(Subsystem subsystem);
+
+  /**
+   * @brief Allocate memory attributed to the current scope (used by replaced operator new)
+   */
+  static void*
+  Allocate(std::size_t size) noexcept;
+
+  /**
+   * @brief Free memory returned by Allocate (used by replaced operator delete)
+   */
+  static void
+  Deallocate(void* ptr) noexcept;
+
+private:
+  static void
+  PrintRecords(std::ostream& os);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MEM_ACCOUNTING_HPP
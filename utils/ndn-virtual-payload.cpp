@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "ndn-virtual-payload.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/lp/tlv.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+namespace tlv = ::ndn::tlv;
+namespace lp = ::ndn::lp;
+
+static size_t
+sizeOfTlv(uint32_t type, size_t valueSize)
+{
+  return tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(valueSize) + valueSize;
+}
+
+/**
+ * @brief TLV element located in a wire encoding, without parsing its value
+ *
+ * Padding is looked up for every packet sent by NetDeviceTransport, so wire encodings are
+ * scanned in place: only TLV type and length fields on the way to the Content are read, and no
+ * sub-elements are allocated.
+ */
+struct WireElement
+{
+  uint32_t type;
+  const uint8_t* begin;
+  const uint8_t* value;
+  const uint8_t* end;
+};
+
+static bool
+readElement(const uint8_t*& pos, const uint8_t* end, WireElement& element)
+{
+  element.begin = pos;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, end, element.type) || !tlv::readVarNumber(pos, end, length)
+      || length > static_cast<uint64_t>(end - pos))
+    return false;
+
+  element.value = pos;
+  element.end = pos + length;
+  pos = element.end;
+  return true;
+}
+
+static bool
+findElement(const WireElement& parent, uint32_t type, WireElement& element)
+{
+  const uint8_t* pos = parent.value;
+  while (pos < parent.end) {
+    if (!readElement(pos, parent.end, element))
+      return false;
+    if (element.type == type)
+      return true;
+  }
+  return false;
+}
+
+static bool
+readNonNegativeInteger(const WireElement& element, uint64_t& number)
+{
+  size_t size = element.end - element.value;
+  if (size != 1 && size != 2 && size != 4 && size != 8)
+    return false;
+
+  number = 0;
+  for (const uint8_t* pos = element.value; pos != element.end; ++pos) {
+    number = (number << 8) | *pos;
+  }
+  return true;
+}
+
+/**
+ * @brief Read payload size if content is a single TLV with payload size (type, length, and up
+ *        to 8 bytes)
+ *
+ * Content is checked before being parsed, so that real payload is never split into elements
+ */
+static bool
+readVirtualContent(const WireElement& content, uint64_t& payloadSize)
+{
+  size_t valueSize = content.end - content.value;
+  if (valueSize < 3 || valueSize > 10 || *content.value != VirtualPayload::TLV_TYPE)
+    return false;
+
+  const uint8_t* pos = content.value;
+  WireElement size;
+  return readElement(pos, content.end, size) && pos == content.end
+         && readNonNegativeInteger(size, payloadSize);
+}
+
+static WireElement
+toWireElement(const Block& block)
+{
+  return {block.type(), block.wire(), block.value(), block.wire() + block.size()};
+}
+
+/**
+ * @brief Get difference between the sizes of @p data encoded with the real and with the
+ *        virtual payload
+ */
+static ssize_t
+getSizeDifference(const WireElement& data)
+{
+  WireElement content;
+  uint64_t payloadSize = 0;
+  if (!findElement(data, tlv::Content, content) || !readVirtualContent(content, payloadSize))
+    return 0;
+
+  size_t dataValueSize = (data.end - data.value) - (content.end - content.begin)
+                         + sizeOfTlv(tlv::Content, payloadSize);
+  return static_cast<ssize_t>(sizeOfTlv(data.type, dataValueSize)) - (data.end - data.begin);
+}
+
+void
+VirtualPayload::Set(Data& data, size_t size)
+{
+  data.setContent(::ndn::makeNonNegativeIntegerBlock(TLV_TYPE, size));
+}
+
+bool
+VirtualPayload::IsVirtual(const Data& data)
+{
+  uint64_t payloadSize = 0;
+  return readVirtualContent(toWireElement(data.getContent()), payloadSize);
+}
+
+size_t
+VirtualPayload::GetSize(const Data& data)
+{
+  uint64_t payloadSize = 0;
+  if (!readVirtualContent(toWireElement(data.getContent()), payloadSize))
+    return 0;
+
+  return payloadSize;
+}
+
+size_t
+VirtualPayload::GetEncodedSize(const Data& data)
+{
+  const Block& wire = data.wireEncode();
+  return wire.size() + getSizeDifference(toWireElement(wire));
+}
+
+size_t
+VirtualPayload::GetPadding(const Block& wire)
+{
+  if (!wire.hasWire())
+    return 0;
+
+  WireElement packet = toWireElement(wire);
+  if (packet.type == tlv::Data) {
+    return std::max<ssize_t>(getSizeDifference(packet), 0);
+  }
+
+  if (packet.type != lp::tlv::LpPacket)
+    return 0;
+
+  WireElement fragment{};
+  bool hasFragment = false;
+  const uint8_t* pos = packet.value;
+  while (pos < packet.end) {
+    WireElement field;
+    if (!readElement(pos, packet.end, field))
+      return 0;
+
+    uint64_t fragCount = 0;
+    if (field.type == lp::tlv::FragCount
+        && (!readNonNegativeInteger(field, fragCount) || fragCount > 1))
+      return 0; // Data with virtual payload is never fragmented by NDNLP
+
+    if (field.type == lp::tlv::Fragment) {
+      fragment = field;
+      hasFragment = true;
+    }
+  }
+
+  if (!hasFragment || fragment.value == fragment.end || *fragment.value != tlv::Data)
+    return 0;
+
+  pos = fragment.value;
+  WireElement data;
+  if (!readElement(pos, fragment.end, data) || pos != fragment.end)
+    return 0;
+
+  ssize_t dataDifference = getSizeDifference(data);
+  if (dataDifference <= 0)
+    return 0;
+
+  size_t fragmentSize = sizeOfTlv(lp::tlv::Fragment,
+                                  (fragment.end - fragment.value) + dataDifference);
+  size_t packetValueSize = (packet.end - packet.value) - (fragment.end - fragment.begin)
+                           + fragmentSize;
+  return sizeOfTlv(lp::tlv::LpPacket, packetValueSize) - wire.size();
+}
+
+} // namespace ndn
+} // namespace ns3
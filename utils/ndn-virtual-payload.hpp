@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_VIRTUAL_PAYLOAD_HPP
+#define NDNSIM_UTILS_VIRTUAL_PAYLOAD_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Data payload that has a size, but no bytes
+ *
+ * Content of a Data packet with virtual payload is a single small TLV that records the payload
+ * size.  Content stores, PIT, and transport buffers therefore hold only the headers, while
+ * NetDeviceTransport pads the ns-3 packets (with ns-3 virtual zero bytes, which are not
+ * allocated) to the size that the Data would have with the real payload, and splits them the
+ * way NDNLP would fragment such Data.  Link airtime and queueing are the same as with the real
+ * payload.
+ */
+class VirtualPayload {
+public:
+  /// @brief TLV type of the Content element that carries the payload size
+  static const uint32_t TLV_TYPE = 200;
+
+  /**
+   * @brief Set virtual payload of @p size bytes as the content of @p data
+   */
+  static void
+  Set(Data& data, size_t size);
+
+  /**
+   * @brief Check whether @p data carries virtual payload
+   */
+  static bool
+  IsVirtual(const Data& data);
+
+  /**
+   * @brief Get size of the virtual payload of @p data, or 0 if the payload is not virtual
+   */
+  static size_t
+  GetSize(const Data& data);
+
+  /**
+   * @brief Get size that @p data would have when encoded with the real payload
+   */
+  static size_t
+  GetEncodedSize(const Data& data);
+
+  /**
+   * @brief Get number of bytes that are missing from the wire encoding of a network or NDNLP
+   *        packet, because it carries Data with virtual payload
+   *
+   * @returns 0 if the packet does not carry Data with virtual payload, or if the payload is so
+   *          small (less than 3 bytes) that the real encoding would be shorter
+   */
+  static size_t
+  GetPadding(const Block& wire);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_VIRTUAL_PAYLOAD_HPP
@@ -41,6 +41,7 @@
 #include "ns3/error-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/data-rate.h"
 
 #include "model/ndn-l3-protocol.hpp"
 
@@ -69,6 +70,8 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_nPartitions(0)
+  , m_imbalance(0.03)
 {
   NS_LOG_FUNCTION(this);
 
@@ -100,6 +103,33 @@ AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
   m_mobilityFactory.SetTypeId(model);
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions, double imbalance/* = 0.03*/)
+{
+  NS_LOG_FUNCTION(this << nPartitions << imbalance);
+  m_nPartitions = nPartitions;
+  m_imbalance = imbalance;
+}
+
+void
+AnnotatedTopologyReader::SetNodeWeight(const std::string& name, double weight)
+{
+  m_nodeWeights[name] = weight;
+}
+
+void
+AnnotatedTopologyReader::SetLinkWeight(const std::string& from, const std::string& to,
+                                       double weight)
+{
+  m_linkWeights[make_pair(from, to)] = weight;
+}
+
+const TopologyPartitioner&
+AnnotatedTopologyReader::GetPartitioner() const
+{
+  return m_partitioner;
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader()
 {
   NS_LOG_FUNCTION(this);
@@ -153,6 +183,8 @@ AnnotatedTopologyReader::GetLinks() const
 NodeContainer
 AnnotatedTopologyReader::Read(void)
 {
+  m_partitioner = TopologyPartitioner(); // drop the graph of a previous Read ()
+
   ifstream topgen;
   topgen.open(GetFileName().c_str());
 
@@ -174,6 +206,14 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct Router {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<Router> routers;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -191,24 +231,21 @@ AnnotatedTopologyReader::Read(void)
     if (name.empty())
       continue;
 
-    Ptr<Node> node;
-
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
-    }
+    routers.push_back(Router{name, latitude, longitude, systemId});
   }
 
   map<string, set<string>> processedLinks; // to eliminate duplications
 
-  if (topgen.eof()) {
+  bool hasLinkSection = !topgen.eof();
+  if (!hasLinkSection) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
-    return m_nodes;
   }
 
+  struct LinkInfo {
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  };
+  vector<LinkInfo> links;
+
   // SeekToSection ("link");
   while (!topgen.eof()) {
     string line;
@@ -221,44 +258,104 @@ AnnotatedTopologyReader::Read(void)
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+    LinkInfo info;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    lineBuffer >> info.from >> info.to >> info.capacity >> info.metric >> info.delay
+      >> info.maxPackets >> info.lossRate;
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
+    if (processedLinks[info.to].size() != 0
+        && processedLinks[info.to].find(info.from) != processedLinks[info.to].end()) {
       continue; // duplicated link
     }
-    processedLinks[from].insert(to);
+    processedLinks[info.from].insert(info.to);
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    links.push_back(info);
+  }
+  topgen.close();
 
-    Link link(fromNode, from, toNode, to);
+  // nodes can be created only after links are known, as system IDs may depend on them
+  if (m_nPartitions > 0) {
+    map<string, uint32_t> vertices;
+    for (const Router& router : routers) {
+      auto weight = m_nodeWeights.find(router.name);
+      vertices[router.name] =
+        m_partitioner.AddVertex(weight != m_nodeWeights.end() ? weight->second : 1.0);
+    }
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+    for (const LinkInfo& info : links) {
+      auto from = vertices.find(info.from);
+      auto to = vertices.find(info.to);
+      if (from == vertices.end() || to == vertices.end())
+        continue; // will be reported below
+
+      double weight = DataRate(info.capacity).GetBitRate() / 1e6;
+      auto linkWeight = m_linkWeights.find(make_pair(info.from, info.to));
+      if (linkWeight == m_linkWeights.end())
+        linkWeight = m_linkWeights.find(make_pair(info.to, info.from));
+      if (linkWeight != m_linkWeights.end())
+        weight = linkWeight->second;
+
+      m_partitioner.AddEdge(from->second, to->second, weight,
+                            info.delay.empty() ? Time() : Time(info.delay));
+    }
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    const vector<uint32_t>& partitions = m_partitioner.Partition(m_nPartitions, m_imbalance);
+    for (size_t i = 0; i < routers.size(); ++i) {
+      routers[i].systemId = partitions[vertices[routers[i].name]];
+    }
+    m_requiredPartitions = m_nPartitions;
+
+    NS_LOG_INFO("Topology partitioned into " << m_nPartitions << " partitions with "
+                                             << m_partitioner.GetNCutEdges()
+                                             << " cut links, lookahead "
+                                             << m_partitioner.GetLookahead());
+  }
+
+  for (const Router& router : routers) {
+    Ptr<Node> node;
+
+    if (abs(router.latitude) > 0.001 && abs(router.latitude) > 0.001)
+      node = CreateNode(router.name, m_scale * router.longitude, -m_scale * router.latitude,
+                        router.systemId);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      node = CreateNode(router.name, var->GetValue(0, 200), var->GetValue(0, 200),
+                        router.systemId);
+      // node = CreateNode (name, systemId);
+    }
+  }
+
+  if (!hasLinkSection)
+    return m_nodes;
+
+  for (const LinkInfo& info : links) {
+    Ptr<Node> fromNode = Names::Find<Node>(m_path, info.from);
+    NS_ASSERT_MSG(fromNode != 0, info.from << " node not found");
+    Ptr<Node> toNode = Names::Find<Node>(m_path, info.to);
+    NS_ASSERT_MSG(toNode != 0, info.to << " node not found");
+
+    Link link(fromNode, info.from, toNode, info.to);
+
+    link.SetAttribute("DataRate", info.capacity);
+    link.SetAttribute("OSPF", info.metric);
+
+    if (!info.delay.empty())
+      link.SetAttribute("Delay", info.delay);
+    if (!info.maxPackets.empty())
+      link.SetAttribute("MaxPackets", info.maxPackets);
 
     // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+    if (!info.lossRate.empty())
+      link.SetAttribute("LossRate", info.lossRate);
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << info.from << " <==> " << info.to << " / " << info.capacity
+                             << " with " << info.metric << " metric (" << info.delay << ", "
+                             << info.maxPackets << ", " << info.lossRate << ")");
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
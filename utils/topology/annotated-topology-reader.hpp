@@ -26,6 +26,10 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/object-factory.h"
 
+#include "topology-partitioner.hpp"
+
+#include <map>
+
 namespace ns3 {
 
 /**
@@ -97,6 +101,43 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Request automatic partitioning of the topology for distributed (MPI) simulations
+   *
+   * Instead of using system IDs from the topology file, nodes are assigned to \p nPartitions
+   * partitions, minimizing expected traffic over the links between partitions and balancing
+   * the load of the nodes, while avoiding to cut links with small delay (that limit lookahead).
+   *
+   * \param nPartitions number of partitions, e.g., MpiInterface::GetSize (); 0 to use system
+   *                    IDs from the topology file
+   * \param imbalance allowed relative excess of the partition load over the average
+   *
+   * Must be called before Read ()
+   */
+  virtual void
+  SetPartitions(uint32_t nPartitions, double imbalance = 0.03);
+
+  /**
+   * \brief Set expected load of the node (e.g., number of applications), used by automatic
+   *        partitioning (default 1)
+   */
+  virtual void
+  SetNodeWeight(const std::string& name, double weight);
+
+  /**
+   * \brief Set expected traffic over the link, used by automatic partitioning (default is link
+   *        capacity in Mbps)
+   */
+  virtual void
+  SetLinkWeight(const std::string& from, const std::string& to, double weight);
+
+  /**
+   * \brief Get partitioner used to assign system IDs to nodes, e.g., to print the achieved cut
+   *        and lookahead of the last Read () (only valid if automatic partitioning is requested)
+   */
+  const TopologyPartitioner&
+  GetPartitioner() const;
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -147,6 +188,12 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  uint32_t m_nPartitions;
+  double m_imbalance;
+  std::map<std::string, double> m_nodeWeights;
+  std::map<std::pair<std::string, std::string>, double> m_linkWeights;
+  TopologyPartitioner m_partitioner;
 };
 }
 
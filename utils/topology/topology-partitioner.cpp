@@ -0,0 +1,447 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <queue>
+#include <random>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+
+/// @brief cost multiplier for cutting an edge with zero delay (lookahead would become zero)
+static const double ZERO_DELAY_PENALTY = 1e6;
+
+/// @brief maximum number of refinement passes on each level
+static const uint32_t MAX_REFINE_PASSES = 10;
+
+TopologyPartitioner::TopologyPartitioner()
+  : m_nPartitions(1)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddVertex(double weight/* = 1.0*/)
+{
+  m_vertexWeights.push_back(weight);
+  m_partitions.push_back(0);
+  return m_vertexWeights.size() - 1;
+}
+
+void
+TopologyPartitioner::AddEdge(uint32_t from, uint32_t to, double weight, Time delay)
+{
+  NS_ASSERT(from < m_vertexWeights.size() && to < m_vertexWeights.size());
+  m_edges.push_back(Edge{from, to, weight, delay});
+}
+
+TopologyPartitioner::Graph
+TopologyPartitioner::MakeGraph() const
+{
+  Time maxDelay;
+  for (const Edge& edge : m_edges) {
+    maxDelay = std::max(maxDelay, edge.delay);
+  }
+
+  Graph graph;
+  graph.vertexWeights = m_vertexWeights;
+  graph.adjacency.resize(m_vertexWeights.size());
+  for (const Edge& edge : m_edges) {
+    if (edge.from == edge.to)
+      continue;
+
+    // the lookahead is the smallest delay among the cut edges, so cutting an edge is
+    // the more expensive, the shorter its delay is
+    double penalty = 1.0;
+    if (maxDelay.IsStrictlyPositive()) {
+      penalty = edge.delay.IsStrictlyPositive() ? maxDelay.GetSeconds() / edge.delay.GetSeconds()
+                                                : ZERO_DELAY_PENALTY;
+    }
+    double cost = std::max(edge.weight, std::numeric_limits<double>::min()) * penalty;
+
+    graph.adjacency[edge.from].push_back(std::make_pair(edge.to, cost));
+    graph.adjacency[edge.to].push_back(std::make_pair(edge.from, cost));
+  }
+  return graph;
+}
+
+const std::vector<uint32_t>&
+TopologyPartitioner::Partition(uint32_t nPartitions, double imbalance/* = 0.03*/)
+{
+  NS_LOG_FUNCTION(this << nPartitions << imbalance);
+  NS_ASSERT(nPartitions > 0);
+
+  m_nPartitions = nPartitions;
+  m_partitions.assign(m_vertexWeights.size(), 0);
+  if (nPartitions == 1 || m_vertexWeights.empty())
+    return m_partitions;
+
+  double totalWeight = std::accumulate(m_vertexWeights.begin(), m_vertexWeights.end(), 0.0);
+  double maxPartitionWeight = (1.0 + imbalance) * totalWeight / nPartitions;
+
+  size_t coarsenTo = std::max<size_t>(15 * nPartitions, 30);
+  double maxVertexWeight = 1.5 * totalWeight / coarsenTo;
+
+  // coarsening
+  std::vector<Graph> levels;
+  std::vector<std::vector<uint32_t>> maps; // vertex of level i => vertex of level i+1
+  levels.push_back(MakeGraph());
+  while (levels.back().vertexWeights.size() > coarsenTo) {
+    std::vector<uint32_t> map;
+    Graph coarse = Coarsen(levels.back(), maxVertexWeight, levels.size(), map);
+    if (coarse.vertexWeights.size() > 0.95 * levels.back().vertexWeights.size())
+      break; // nothing left to match
+
+    NS_LOG_DEBUG("Level " << levels.size() << ": " << coarse.vertexWeights.size() << " vertices");
+    levels.push_back(std::move(coarse));
+    maps.push_back(std::move(map));
+  }
+
+  // initial partitioning
+  std::vector<uint32_t> partitions =
+    GrowPartitions(levels.back(), nPartitions, maxPartitionWeight);
+  Refine(levels.back(), nPartitions, maxPartitionWeight, partitions);
+
+  // uncoarsening
+  for (size_t level = levels.size() - 1; level > 0; --level) {
+    const std::vector<uint32_t>& map = maps[level - 1];
+    std::vector<uint32_t> projected(map.size());
+    for (size_t vertex = 0; vertex < map.size(); ++vertex) {
+      projected[vertex] = partitions[map[vertex]];
+    }
+    partitions.swap(projected);
+    Refine(levels[level - 1], nPartitions, maxPartitionWeight, partitions);
+  }
+
+  m_partitions.swap(partitions);
+
+  NS_LOG_INFO(m_nPartitions << " partitions, " << GetNCutEdges() << " cut edges (weight "
+                            << GetCutWeight() << "), lookahead " << GetLookahead());
+  return m_partitions;
+}
+
+TopologyPartitioner::Graph
+TopologyPartitioner::Coarsen(const Graph& graph, double maxVertexWeight, uint32_t seed,
+                             std::vector<uint32_t>& map)
+{
+  size_t nVertices = graph.vertexWeights.size();
+
+  std::vector<uint32_t> order(nVertices);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937 random(seed);
+  std::shuffle(order.begin(), order.end(), random);
+
+  // heavy-edge matching
+  std::vector<uint32_t> match(nVertices, UNASSIGNED);
+  for (uint32_t vertex : order) {
+    if (match[vertex] != UNASSIGNED)
+      continue;
+
+    uint32_t best = vertex;
+    double bestCost = 0;
+    for (const auto& neighbor : graph.adjacency[vertex]) {
+      if (match[neighbor.first] != UNASSIGNED || neighbor.first == vertex)
+        continue;
+      if (graph.vertexWeights[vertex] + graph.vertexWeights[neighbor.first] > maxVertexWeight)
+        continue;
+      if (neighbor.second > bestCost) {
+        best = neighbor.first;
+        bestCost = neighbor.second;
+      }
+    }
+    match[vertex] = best;
+    match[best] = vertex;
+  }
+
+  map.assign(nVertices, UNASSIGNED);
+  uint32_t nCoarse = 0;
+  for (uint32_t vertex = 0; vertex < nVertices; ++vertex) {
+    if (map[vertex] != UNASSIGNED)
+      continue;
+    map[vertex] = nCoarse;
+    map[match[vertex]] = nCoarse;
+    ++nCoarse;
+  }
+
+  Graph coarse;
+  coarse.vertexWeights.assign(nCoarse, 0.0);
+  coarse.adjacency.resize(nCoarse);
+  for (uint32_t vertex = 0; vertex < nVertices; ++vertex) {
+    coarse.vertexWeights[map[vertex]] += graph.vertexWeights[vertex];
+  }
+
+  // merge parallel edges, dropping the ones collapsed inside coarse vertices
+  std::vector<double> costs(nCoarse, 0.0);
+  std::vector<uint32_t> touched;
+  for (uint32_t vertex = 0; vertex < nVertices; ++vertex) {
+    if (vertex > match[vertex])
+      continue; // already processed together with its match
+
+    uint32_t coarseVertex = map[vertex];
+    for (uint32_t member : {vertex, match[vertex]}) {
+      for (const auto& neighbor : graph.adjacency[member]) {
+        uint32_t coarseNeighbor = map[neighbor.first];
+        if (coarseNeighbor == coarseVertex)
+          continue;
+        if (costs[coarseNeighbor] == 0)
+          touched.push_back(coarseNeighbor);
+        costs[coarseNeighbor] += neighbor.second;
+      }
+      if (member == match[member])
+        break;
+    }
+
+    for (uint32_t coarseNeighbor : touched) {
+      coarse.adjacency[coarseVertex].push_back(std::make_pair(coarseNeighbor,
+                                                              costs[coarseNeighbor]));
+      costs[coarseNeighbor] = 0;
+    }
+    touched.clear();
+  }
+
+  return coarse;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::GrowPartitions(const Graph& graph, uint32_t nPartitions,
+                                    double maxPartitionWeight)
+{
+  size_t nVertices = graph.vertexWeights.size();
+  double totalWeight =
+    std::accumulate(graph.vertexWeights.begin(), graph.vertexWeights.end(), 0.0);
+
+  // breadth-first order of vertices defines seeds, so partitions grow next to each other
+  std::vector<uint32_t> seeds;
+  std::vector<bool> visited(nVertices, false);
+  for (uint32_t root = 0; root < nVertices; ++root) {
+    if (visited[root])
+      continue;
+    visited[root] = true;
+    seeds.push_back(root);
+    for (size_t i = seeds.size() - 1; i < seeds.size(); ++i) {
+      for (const auto& neighbor : graph.adjacency[seeds[i]]) {
+        if (!visited[neighbor.first]) {
+          visited[neighbor.first] = true;
+          seeds.push_back(neighbor.first);
+        }
+      }
+    }
+  }
+
+  std::vector<uint32_t> partitions(nVertices, UNASSIGNED);
+  std::vector<double> connectivity(nVertices, 0.0);
+  auto nextSeed = seeds.begin();
+
+  double assignedWeight = 0;
+  for (uint32_t partition = 0; partition + 1 < nPartitions; ++partition) {
+    double target = (totalWeight - assignedWeight) / (nPartitions - partition);
+    double weight = 0;
+
+    std::fill(connectivity.begin(), connectivity.end(), 0.0);
+    std::priority_queue<std::pair<double, uint32_t>> frontier;
+
+    while (weight < target) {
+      uint32_t vertex = UNASSIGNED;
+      if (frontier.empty()) {
+        // start (or restart, if the component is exhausted) from the next unassigned seed
+        while (nextSeed != seeds.end() && partitions[*nextSeed] != UNASSIGNED)
+          ++nextSeed;
+        if (nextSeed == seeds.end())
+          break;
+        vertex = *nextSeed;
+        ++nextSeed;
+      }
+      else {
+        std::pair<double, uint32_t> top = frontier.top();
+        frontier.pop();
+        vertex = top.second;
+        if (partitions[vertex] != UNASSIGNED || top.first < connectivity[vertex])
+          continue; // already taken or stale entry
+      }
+
+      if (weight > 0 && weight + graph.vertexWeights[vertex] > maxPartitionWeight) {
+        connectivity[vertex] = std::numeric_limits<double>::max(); // does not fit
+        continue;
+      }
+
+      partitions[vertex] = partition;
+      weight += graph.vertexWeights[vertex];
+      for (const auto& neighbor : graph.adjacency[vertex]) {
+        if (partitions[neighbor.first] != UNASSIGNED)
+          continue;
+        connectivity[neighbor.first] += neighbor.second;
+        frontier.push(std::make_pair(connectivity[neighbor.first], neighbor.first));
+      }
+    }
+    assignedWeight += weight;
+  }
+
+  for (uint32_t& partition : partitions) {
+    if (partition == UNASSIGNED)
+      partition = nPartitions - 1;
+  }
+  return partitions;
+}
+
+void
+TopologyPartitioner::Refine(const Graph& graph, uint32_t nPartitions, double maxPartitionWeight,
+                            std::vector<uint32_t>& partitions)
+{
+  size_t nVertices = graph.vertexWeights.size();
+
+  std::vector<double> weights(nPartitions, 0.0);
+  for (uint32_t vertex = 0; vertex < nVertices; ++vertex) {
+    weights[partitions[vertex]] += graph.vertexWeights[vertex];
+  }
+
+  std::vector<double> connectivity(nPartitions, 0.0);
+  for (uint32_t pass = 0; pass < MAX_REFINE_PASSES; ++pass) {
+    uint32_t nMoves = 0;
+
+    for (uint32_t vertex = 0; vertex < nVertices; ++vertex) {
+      uint32_t from = partitions[vertex];
+      double vertexWeight = graph.vertexWeights[vertex];
+
+      std::fill(connectivity.begin(), connectivity.end(), 0.0);
+      for (const auto& neighbor : graph.adjacency[vertex]) {
+        connectivity[partitions[neighbor.first]] += neighbor.second;
+      }
+
+      // vertices of overweight partitions move anywhere, others only to adjacent partitions
+      // when that reduces the cut or, with the same cut, improves the balance
+      bool mustLeave = weights[from] > maxPartitionWeight;
+      uint32_t best = from;
+      double bestGain = 0;
+      for (uint32_t to = 0; to < nPartitions; ++to) {
+        if (to == from || weights[to] + vertexWeight > maxPartitionWeight)
+          continue;
+        if (!mustLeave && connectivity[to] == 0)
+          continue;
+
+        double gain = connectivity[to] - connectivity[from];
+        bool isBetter = false;
+        if (best == from) {
+          isBetter = mustLeave || gain > 0
+                     || (gain == 0 && weights[to] + vertexWeight < weights[from]);
+        }
+        else {
+          isBetter = gain > bestGain || (gain == bestGain && weights[to] < weights[best]);
+        }
+
+        if (isBetter) {
+          best = to;
+          bestGain = gain;
+        }
+      }
+
+      if (best != from) {
+        partitions[vertex] = best;
+        weights[from] -= vertexWeight;
+        weights[best] += vertexWeight;
+        ++nMoves;
+      }
+    }
+
+    if (nMoves == 0)
+      break;
+  }
+}
+
+const std::vector<uint32_t>&
+TopologyPartitioner::GetPartitions() const
+{
+  return m_partitions;
+}
+
+uint32_t
+TopologyPartitioner::GetNCutEdges() const
+{
+  uint32_t nCutEdges = 0;
+  for (const Edge& edge : m_edges) {
+    if (m_partitions[edge.from] != m_partitions[edge.to])
+      ++nCutEdges;
+  }
+  return nCutEdges;
+}
+
+double
+TopologyPartitioner::GetCutWeight() const
+{
+  double cutWeight = 0;
+  for (const Edge& edge : m_edges) {
+    if (m_partitions[edge.from] != m_partitions[edge.to])
+      cutWeight += edge.weight;
+  }
+  return cutWeight;
+}
+
+Time
+TopologyPartitioner::GetLookahead() const
+{
+  Time lookahead = Time::Max();
+  for (const Edge& edge : m_edges) {
+    if (m_partitions[edge.from] != m_partitions[edge.to])
+      lookahead = std::min(lookahead, edge.delay);
+  }
+  return lookahead;
+}
+
+std::vector<double>
+TopologyPartitioner::GetPartitionWeights() const
+{
+  std::vector<double> weights(m_nPartitions, 0.0);
+  for (size_t vertex = 0; vertex < m_vertexWeights.size(); ++vertex) {
+    weights[m_partitions[vertex]] += m_vertexWeights[vertex];
+  }
+  return weights;
+}
+
+void
+TopologyPartitioner::PrintReport(std::ostream& os) const
+{
+  os << "Partitions: " << m_nPartitions << ", cut links: " << GetNCutEdges()
+     << " (weight " << GetCutWeight() << "), lookahead: ";
+  Time lookahead = GetLookahead();
+  if (lookahead == Time::Max())
+    os << "unlimited";
+  else
+    os << lookahead.As(Time::MS);
+  os << "\n";
+
+  std::vector<uint32_t> sizes(m_nPartitions, 0);
+  for (uint32_t partition : m_partitions) {
+    ++sizes[partition];
+  }
+  std::vector<double> weights = GetPartitionWeights();
+  for (uint32_t partition = 0; partition < m_nPartitions; ++partition) {
+    os << "  " << partition << ": " << sizes[partition] << " nodes, load "
+       << weights[partition] << "\n";
+  }
+}
+
+} // namespace ns3
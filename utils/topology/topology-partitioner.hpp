@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Multilevel k-way partitioner of a topology graph for distributed (MPI) simulations
+ *
+ * Vertices are weighted by the expected load of the node (e.g., applications installed on it),
+ * edges by the expected traffic on the link.  The partitioner minimizes the total weight of the
+ * cut edges while keeping partition weights within the allowed imbalance.  Cutting a link with a
+ * short delay is penalized in proportion to how much it would reduce the lookahead of the
+ * distributed simulator (the smallest delay of all links crossing partitions).
+ *
+ * The graph is coarsened by heavy-edge matching, the coarsest graph is split by greedy graph
+ * growing, and the partition is projected back level by level with greedy boundary refinement.
+ */
+class TopologyPartitioner {
+public:
+  TopologyPartitioner();
+
+  /**
+   * \brief Add vertex with the specified load
+   * \returns index of the vertex
+   */
+  uint32_t
+  AddVertex(double weight = 1.0);
+
+  /**
+   * \brief Add undirected edge between two vertices
+   * \param weight expected traffic on the edge
+   * \param delay propagation delay of the edge (zero-delay edges are never cut if avoidable)
+   */
+  void
+  AddEdge(uint32_t from, uint32_t to, double weight, Time delay);
+
+  /**
+   * \brief Partition the graph
+   * \param nPartitions number of partitions
+   * \param imbalance allowed relative excess of a partition weight over the average
+   * \returns partition index for every vertex
+   */
+  const std::vector<uint32_t>&
+  Partition(uint32_t nPartitions, double imbalance = 0.03);
+
+  /**
+   * \brief Get partition index for every vertex, as calculated by the last Partition call
+   */
+  const std::vector<uint32_t>&
+  GetPartitions() const;
+
+  /**
+   * \brief Get number of edges crossing partitions
+   */
+  uint32_t
+  GetNCutEdges() const;
+
+  /**
+   * \brief Get total weight of the edges crossing partitions
+   */
+  double
+  GetCutWeight() const;
+
+  /**
+   * \brief Get the smallest delay of the edges crossing partitions (Time::Max () if none)
+   */
+  Time
+  GetLookahead() const;
+
+  /**
+   * \brief Get total vertex weight of each partition
+   */
+  std::vector<double>
+  GetPartitionWeights() const;
+
+  /**
+   * \brief Print number of cut edges, cut weight, lookahead, and load of each partition
+   */
+  void
+  PrintReport(std::ostream& os) const;
+
+private:
+  struct Graph {
+    std::vector<double> vertexWeights;
+    /// adjacency lists of (neighbor, cost) with parallel edges merged
+    std::vector<std::vector<std::pair<uint32_t, double>>> adjacency;
+  };
+
+  struct Edge {
+    uint32_t from;
+    uint32_t to;
+    double weight;
+    Time delay;
+  };
+
+  Graph
+  MakeGraph() const;
+
+  static Graph
+  Coarsen(const Graph& graph, double maxVertexWeight, uint32_t seed, std::vector<uint32_t>& map);
+
+  static std::vector<uint32_t>
+  GrowPartitions(const Graph& graph, uint32_t nPartitions, double maxPartitionWeight);
+
+  static void
+  Refine(const Graph& graph, uint32_t nPartitions, double maxPartitionWeight,
+         std::vector<uint32_t>& partitions);
+
+private:
+  std::vector<double> m_vertexWeights;
+  std::vector<Edge> m_edges;
+
+  uint32_t m_nPartitions;
+  std::vector<uint32_t> m_partitions;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
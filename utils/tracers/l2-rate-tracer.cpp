@@ -84,30 +84,30 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
   : L2Tracer(node)
   , m_os(os)
+  , m_sampler(ndn::TracerSampler::INVALID_ID)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L2RateTracer::~L2RateTracer()
 {
-  m_printEvent.Cancel();
+  ndn::TracerSampler::Unregister(m_sampler);
 }
 
 void
 L2RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
+  ndn::TracerSampler::Unregister(m_sampler);
+  m_sampler = ndn::TracerSampler::Register(m_period, m_os,
+                                           [this] (std::ostream& os) { PeriodicPrinter(os); });
 }
 
 void
-L2RateTracer::PeriodicPrinter()
+L2RateTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  Print(os);
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
 void
@@ -21,6 +21,7 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-sampler.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -83,7 +84,7 @@ public:
 
 private:
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
   void
   Reset();
@@ -91,7 +92,7 @@ private:
 private:
   std::shared_ptr<std::ostream> m_os;
   Time m_period;
-  EventId m_printEvent;
+  ndn::TracerSampler::Id m_sampler;
 
   mutable std::tuple<Stats, Stats, Stats, Stats> m_stats;
 };
@@ -19,8 +19,8 @@
 
 #include "ndn-app-delay-tracer.hpp"
 #include "ns3/node.h"
+#include "ns3/application.h"
 #include "ns3/packet.h"
-#include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
 
@@ -28,6 +28,8 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
@@ -49,7 +51,8 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file,
+                           TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -76,17 +79,14 @@ AppDelayTracer::InstallAll(const std::string& file)
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -113,17 +113,14 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -148,13 +145,98 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   Ptr<AppDelayTracer> trace = Install(node, outputStream);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  InitializeOutput(tracers, outputStream, format);
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+static shared_ptr<std::ostream>
+OpenOutput(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+void
+AppDelayTracer::InstallAllSummaries(const std::string& file, Time interval,
+                                    bool perNode /* = false*/,
+                                    TraceFormat format /* = TraceFormat::TEXT*/)
+{
+  shared_ptr<std::ostream> outputStream = OpenOutput(file);
+  if (outputStream == nullptr)
+    return;
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->SetSummaryInterval(interval, perNode);
+    tracers.push_back(trace);
+  }
+
+  InitializeOutput(tracers, outputStream, format, true);
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+AppDelayTracer::InstallSummaries(const NodeContainer& nodes, const std::string& file,
+                                 Time interval, bool perNode /* = false*/,
+                                 TraceFormat format /* = TraceFormat::TEXT*/)
+{
+  shared_ptr<std::ostream> outputStream = OpenOutput(file);
+  if (outputStream == nullptr)
+    return;
+
+  std::list<Ptr<AppDelayTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    trace->SetSummaryInterval(interval, perNode);
+    tracers.push_back(trace);
+  }
+
+  InitializeOutput(tracers, outputStream, format, true);
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+AppDelayTracer::InitializeOutput(const std::list<Ptr<AppDelayTracer>>& tracers,
+                                 shared_ptr<std::ostream> outputStream, TraceFormat format,
+                                 bool isSummary /* = false*/)
+{
+  if (tracers.empty())
+    return;
+
+  const TraceSchema& schema = isSummary ? GetSummarySchema() : GetSchema();
+
+  if (format == TraceFormat::TEXT) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
+    if (isSummary) {
+      for (size_t i = 0; i < schema.size(); i++) {
+        *outputStream << (i > 0 ? "\t" : "") << schema[i].name;
+      }
+    }
+    else {
+      tracers.front()->PrintHeader(*outputStream);
+    }
     *outputStream << "\n";
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  // records are formatted and written out by a background thread
+  auto writer = make_shared<AsyncTraceWriter>(TraceWriter::Create(format, outputStream, schema));
+  for (const auto& tracer : tracers) {
+    tracer->m_writer = writer;
+  }
 }
 
 Ptr<AppDelayTracer>
@@ -174,6 +256,10 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_writer(make_shared<TextTraceWriter>(os, GetSchema()))
+  , m_isSummary(false)
+  , m_perNode(false)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -187,23 +273,44 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
   , m_os(os)
+  , m_writer(make_shared<TextTraceWriter>(os, GetSchema()))
+  , m_isSummary(false)
+  , m_perNode(false)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
+  if (m_nodePtr == 0) {
+    // node is specified by its ID
+    uint32_t id = 0;
+    if (!boost::conversion::try_lexical_convert(node, id) || id >= NodeList::GetNNodes()) {
+      NS_FATAL_ERROR("Node \"" << node << "\" is neither a name registered with Names nor an ID "
+                     "of an existing node");
+    }
+    m_nodePtr = NodeList::GetNode(id);
+  }
+
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  TracerSampler::Unregister(m_sampler);
+}
 
 void
 AppDelayTracer::Connect()
 {
-  Config::ConnectWithoutContext("/NodeList/" + m_node
-                                  + "/ApplicationList/*/LastRetransmittedInterestDataDelay",
-                                MakeCallback(&AppDelayTracer::LastRetransmittedInterestDataDelay,
-                                             this));
-
-  Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/FirstInterestDataDelay",
-                                MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
+  // connect directly to the applications, resolving "/NodeList/<node>/ApplicationList/*" config
+  // path for every node makes installation on all nodes quadratic
+  for (uint32_t i = 0; i < m_nodePtr->GetNApplications(); ++i) {
+    Ptr<Application> app = m_nodePtr->GetApplication(i);
+    app->TraceConnectWithoutContext("LastRetransmittedInterestDataDelay",
+                                    MakeCallback(&AppDelayTracer::
+                                                   LastRetransmittedInterestDataDelay, this));
+    app->TraceConnectWithoutContext("FirstInterestDataDelay",
+                                    MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
+  }
 }
 
 void
@@ -230,28 +337,115 @@ AppDelayTracer::PrintHeader(std::ostream& os) const
      << "";
 }
 
+const TraceSchema&
+AppDelayTracer::GetSchema()
+{
+  static const TraceSchema schema = {
+    {"Time", TraceColumn::REAL},
+    {"Node", TraceColumn::STRING},
+    {"AppId", TraceColumn::INTEGER},
+    {"SeqNo", TraceColumn::INTEGER},
+    {"Type", TraceColumn::STRING},
+    {"DelayS", TraceColumn::REAL},
+    {"DelayUS", TraceColumn::REAL},
+    {"RetxCount", TraceColumn::INTEGER},
+    {"HopCount", TraceColumn::INTEGER},
+  };
+  return schema;
+}
+
+void
+AppDelayTracer::SetSummaryInterval(Time interval, bool perNode /* = false*/)
+{
+  m_isSummary = true;
+  m_perNode = perNode;
+  m_summaries.clear();
+  m_writer = make_shared<TextTraceWriter>(m_os, GetSummarySchema());
+
+  TracerSampler::Unregister(m_sampler);
+  // summaries are written through m_writer, possibly by a background thread, never into the stream
+  // provided by the sampler
+  m_sampler = TracerSampler::Register(interval, nullptr,
+                                      [this] (std::ostream&) { PrintSummaries(); });
+}
+
+const TraceSchema&
+AppDelayTracer::GetSummarySchema()
+{
+  static const TraceSchema schema = {
+    {"Time", TraceColumn::REAL},
+    {"Node", TraceColumn::STRING},
+    {"AppId", TraceColumn::INTEGER},
+    {"Metric", TraceColumn::STRING},
+    {"Count", TraceColumn::INTEGER},
+    {"Mean", TraceColumn::REAL},
+    {"P50", TraceColumn::INTEGER},
+    {"P90", TraceColumn::INTEGER},
+    {"P99", TraceColumn::INTEGER},
+    {"P999", TraceColumn::INTEGER},
+    {"Max", TraceColumn::INTEGER},
+  };
+  return schema;
+}
+
+AppDelayTracer::DelaySummary&
+AppDelayTracer::GetSummary(Ptr<App> app)
+{
+  return m_summaries[m_perNode ? -1 : static_cast<int64_t>(app->GetId())];
+}
+
+void
+AppDelayTracer::PrintSummaries()
+{
+  double now = Simulator::Now().ToDouble(Time::S);
+
+  for (auto& entry : m_summaries) {
+    DelaySummary& summary = entry.second;
+    if (summary.fullDelay.GetTotal() == 0 && summary.lastDelay.GetTotal() == 0)
+      continue;
+
+    for (auto metric : {std::make_pair("FullDelayUS", &summary.fullDelay),
+                        std::make_pair("LastDelayUS", &summary.lastDelay),
+                        std::make_pair("RetxCount", &summary.retxCount),
+                        std::make_pair("HopCount", &summary.hopCount)}) {
+      const HdrHistogram& histogram = *metric.second;
+      m_writer->Write({now, m_node, entry.first, metric.first, histogram.GetTotal(),
+                       histogram.GetMean(), histogram.GetQuantile(0.5), histogram.GetQuantile(0.9),
+                       histogram.GetQuantile(0.99), histogram.GetQuantile(0.999),
+                       histogram.GetMax()});
+      metric.second->Reset();
+    }
+  }
+}
+
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount 
-        << "\n";
+  if (m_isSummary) {
+    GetSummary(app).lastDelay.Add(static_cast<uint64_t>(delay.GetMicroSeconds()));
+    return;
+  }
+
+  m_writer->Write({Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "LastDelay",
+                   delay.ToDouble(Time::S), delay.ToDouble(Time::US), 1, hopCount});
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount
-        << "\n";
+  if (m_isSummary) {
+    DelaySummary& summary = GetSummary(app);
+    summary.fullDelay.Add(static_cast<uint64_t>(delay.GetMicroSeconds()));
+    summary.retxCount.Add(retxCount);
+    if (hopCount >= 0) // hop count is -1 when Data does not carry it
+      summary.hopCount.Add(static_cast<uint64_t>(hopCount));
+    return;
+  }
+
+  m_writer->Write({Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "FullDelay",
+                   delay.ToDouble(Time::S), delay.ToDouble(Time::US), retxCount, hopCount});
 }
 
 } // namespace ndn
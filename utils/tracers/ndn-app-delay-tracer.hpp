@@ -21,6 +21,9 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-sampler.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -30,6 +33,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -50,20 +54,23 @@ public:
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    *
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    *
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -72,9 +79,10 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *        second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -91,6 +99,37 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers that write delay summaries on all simulation nodes
+   *
+   * Instead of a record per received Data, every @p interval the tracers write, for each
+   * application (or each node) that received Data during the interval, one record per metric
+   * with the count, mean, quantiles, and maximum of the metric.  See GetSummarySchema.
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param interval How often summaries will be written into the trace file
+   * @param perNode Summarize all applications of a node together (AppId column is -1)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
+   */
+  static void
+  InstallAllSummaries(const std::string& file, Time interval, bool perNode = false,
+                      TraceFormat format = TraceFormat::TEXT);
+
+  /**
+   * @brief Helper method to install tracers that write delay summaries on the selected nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param interval How often summaries will be written into the trace file
+   * @param perNode Summarize all applications of a node together (AppId column is -1)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
+   *
+   * @see InstallAllSummaries
+   */
+  static void
+  InstallSummaries(const NodeContainer& nodes, const std::string& file, Time interval,
+                   bool perNode = false, TraceFormat format = TraceFormat::TEXT);
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -127,7 +166,53 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Get columns of trace records (names match the header of text traces)
+   */
+  static const TraceSchema&
+  GetSchema();
+
+  /**
+   * @brief Switch the tracer from per-packet records to summaries written every @p interval
+   *
+   * @param interval How often summaries will be written
+   * @param perNode Summarize all applications of the node together
+   */
+  void
+  SetSummaryInterval(Time interval, bool perNode = false);
+
+  /**
+   * @brief Get columns of summary records
+   *
+   * Metric is one of FullDelayUS, LastDelayUS, RetxCount, and HopCount.  HopCount counts only
+   * Data with a known hop count, so its Count can be lower.  Quantiles are computed from
+   * HdrHistogram and overestimate the exact values by less than 1%.
+   */
+  static const TraceSchema&
+  GetSummarySchema();
+
 private:
+  static void
+  InitializeOutput(const std::list<Ptr<AppDelayTracer>>& tracers,
+                   shared_ptr<std::ostream> outputStream, TraceFormat format,
+                   bool isSummary = false);
+
+  void
+  PrintSummaries();
+
+  /**
+   * @brief Distributions of delay metrics of one application (or node) over one interval
+   */
+  struct DelaySummary {
+    HdrHistogram fullDelay;
+    HdrHistogram lastDelay;
+    HdrHistogram retxCount;
+    HdrHistogram hopCount;
+  };
+
+  DelaySummary&
+  GetSummary(Ptr<App> app);
+
   void
   Connect();
 
@@ -142,6 +227,12 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceWriter> m_writer;
+
+  bool m_isSummary;
+  bool m_perNode;
+  std::map<int64_t, DelaySummary> m_summaries; ///< @brief keyed by AppId, -1 if per node
+  TracerSampler::Id m_sampler;
 };
 
 } // namespace ndn
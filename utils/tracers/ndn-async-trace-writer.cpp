@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-async-trace-writer.hpp"
+#include "../ndn-mem-accounting.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <chrono>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AsyncTraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+AsyncTraceWriter::AsyncTraceWriter(shared_ptr<TraceWriter> writer, size_t capacity)
+  : TraceWriter(nullptr, writer->GetSchema())
+  , m_writer(writer)
+  , m_head(0)
+  , m_nFlushRequests(0)
+  , m_isStopping(false)
+  , m_cachedTail(0)
+  , m_stats{0, 0, 0}
+  , m_tail(0)
+  , m_nFlushes(0)
+{
+  NS_ASSERT_MSG(m_schema.size() <= MAX_COLUMNS, "Too many columns for AsyncTraceWriter");
+  MemAccounting::Scope scope(MemAccounting::TRACER, MemAccounting::NO_NODE);
+
+  size_t size = 1;
+  while (size < std::max<size_t>(capacity, 2)) {
+    size <<= 1;
+  }
+  m_ring.resize(size);
+  m_mask = size - 1;
+
+  m_thread = std::thread(&AsyncTraceWriter::Run, this);
+}
+
+AsyncTraceWriter::~AsyncTraceWriter()
+{
+  m_isStopping.store(true, std::memory_order_release);
+  m_thread.join();
+
+  NS_LOG_INFO("Written " << m_stats.nRecords << " records, " << m_stats.nStalls
+                         << " stalls on full ring, maximum occupancy " << m_stats.maxOccupancy
+                         << "/" << m_ring.size());
+}
+
+void
+AsyncTraceWriter::Write(const TraceValue* record, size_t size)
+{
+  NS_ASSERT(size == m_schema.size());
+
+  uint64_t head = m_head.load(std::memory_order_relaxed);
+  if (head - m_cachedTail == m_ring.size()) {
+    m_cachedTail = m_tail.load(std::memory_order_acquire);
+    if (head - m_cachedTail == m_ring.size()) {
+      ++m_stats.nStalls;
+      do {
+        std::this_thread::yield();
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+      } while (head - m_cachedTail == m_ring.size());
+    }
+  }
+
+  Slot& slot = m_ring[head & m_mask];
+  slot.size = size;
+  for (size_t i = 0; i < size; ++i) {
+    if (m_schema[i].type == TraceColumn::STRING) {
+      slot.values[i].string = m_strings.insert(record[i].string).first->c_str();
+    }
+    else {
+      slot.values[i] = record[i];
+    }
+  }
+
+  m_head.store(head + 1, std::memory_order_release);
+
+  ++m_stats.nRecords;
+  m_stats.maxOccupancy = std::max(m_stats.maxOccupancy, head + 1 - m_cachedTail);
+}
+
+void
+AsyncTraceWriter::Flush()
+{
+  uint64_t request = m_nFlushRequests.fetch_add(1, std::memory_order_release) + 1;
+  while (m_nFlushes.load(std::memory_order_acquire) < request) {
+    std::this_thread::yield();
+  }
+}
+
+void
+AsyncTraceWriter::Run()
+{
+  // no ns-3 logging in this thread, it is not thread-safe
+  MemAccounting::Scope scope(MemAccounting::TRACER, MemAccounting::NO_NODE);
+  auto backoff = std::chrono::microseconds(10);
+  const auto maxBackoff = std::chrono::microseconds(1000);
+
+  while (true) {
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint64_t head = m_head.load(std::memory_order_acquire);
+
+    if (tail != head) {
+      for (; tail != head; ++tail) {
+        const Slot& slot = m_ring[tail & m_mask];
+        m_writer->Write(slot.values, slot.size);
+
+        // release slots in batches to limit cache line ping-pong with the producer
+        if ((tail & 0xFF) == 0xFF) {
+          m_tail.store(tail + 1, std::memory_order_release);
+        }
+      }
+      m_tail.store(tail, std::memory_order_release);
+      backoff = std::chrono::microseconds(10);
+      continue;
+    }
+
+    uint64_t nFlushRequests = m_nFlushRequests.load(std::memory_order_acquire);
+    if (m_nFlushes.load(std::memory_order_relaxed) < nFlushRequests) {
+      // everything requested before the flush has been written (head is read after the request)
+      if (m_head.load(std::memory_order_acquire) == tail) {
+        m_writer->Flush();
+        m_nFlushes.store(nFlushRequests, std::memory_order_release);
+      }
+      continue;
+    }
+
+    if (m_isStopping.load(std::memory_order_acquire)) {
+      if (m_head.load(std::memory_order_acquire) == tail) {
+        break;
+      }
+      continue;
+    }
+
+    std::this_thread::sleep_for(backoff);
+    backoff = std::min(backoff * 2, maxBackoff);
+  }
+
+  m_writer->Flush();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ASYNC_TRACE_WRITER_HPP
+#define NDN_ASYNC_TRACE_WRITER_HPP
+
+#include "ndn-trace-writer.hpp"
+
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Trace writer that formats and writes records in a background thread
+ *
+ * Records are copied into a single-producer/single-consumer lock-free ring of fixed-size slots;
+ * the background thread passes them to the wrapped writer (text or binary), so the simulation
+ * never waits for formatting, compression, or disk I/O.  If the ring is full, the simulation
+ * waits for a free slot (such stalls are counted, see GetStats).
+ *
+ * String values are interned on the simulation side, so they do not need to outlive Write.
+ * The wrapped writer is flushed and the thread is stopped when the writer is destroyed (e.g., when
+ * Destroy() of the tracer is called).  All methods must be called from the simulation thread.
+ */
+class AsyncTraceWriter : public TraceWriter {
+public:
+  static const size_t MAX_COLUMNS = 12;
+  static const size_t DEFAULT_CAPACITY = 16384;
+
+  /**
+   * @brief Back-pressure statistics
+   */
+  struct Stats {
+    uint64_t nRecords;     ///< @brief records written
+    uint64_t nStalls;      ///< @brief number of times Write waited for a free slot
+    uint64_t maxOccupancy; ///< @brief maximum observed number of records in the ring
+  };
+
+  /**
+   * @param writer    writer that is used by the background thread
+   * @param capacity  number of slots in the ring (rounded up to a power of two)
+   */
+  explicit
+  AsyncTraceWriter(shared_ptr<TraceWriter> writer, size_t capacity = DEFAULT_CAPACITY);
+
+  ~AsyncTraceWriter();
+
+  using TraceWriter::Write;
+
+  virtual void
+  Write(const TraceValue* record, size_t size) override;
+
+  /**
+   * @brief Wait until all records are written out by the wrapped writer
+   */
+  virtual void
+  Flush() override;
+
+  const Stats&
+  GetStats() const
+  {
+    return m_stats;
+  }
+
+private:
+  void
+  Run();
+
+private:
+  struct Slot {
+    TraceValue values[MAX_COLUMNS];
+    size_t size;
+  };
+
+  shared_ptr<TraceWriter> m_writer;
+  std::vector<Slot> m_ring;
+  uint64_t m_mask;
+
+  // written by the simulation thread
+  alignas(64) std::atomic<uint64_t> m_head;
+  std::atomic<uint64_t> m_nFlushRequests;
+  std::atomic<bool> m_isStopping;
+  uint64_t m_cachedTail;
+  std::unordered_set<std::string> m_strings; ///< @brief interned strings, nodes are never moved
+  Stats m_stats;
+
+  // written by the background thread
+  alignas(64) std::atomic<uint64_t> m_tail;
+  std::atomic<uint64_t> m_nFlushes;
+
+  std::thread m_thread;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ASYNC_TRACE_WRITER_HPP
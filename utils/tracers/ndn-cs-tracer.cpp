@@ -29,6 +29,8 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
 
 #include <boost/lexical_cast.hpp>
 
@@ -48,7 +50,8 @@ CsTracer::Destroy()
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -75,18 +78,15 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -113,18 +113,15 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -149,13 +146,32 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  InitializeOutput(tracers, outputStream, format);
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+CsTracer::InitializeOutput(const std::list<Ptr<CsTracer>>& tracers,
+                           shared_ptr<std::ostream> outputStream, TraceFormat format)
+{
+  if (tracers.empty())
+    return;
+
+  if (format == TraceFormat::TEXT) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  // records are formatted and written out by a background thread
+  auto writer = make_shared<AsyncTraceWriter>(TraceWriter::Create(format, outputStream,
+                                                                  GetSchema()));
+  for (const auto& tracer : tracers) {
+    tracer->m_writer = writer;
+    // register again, so that the sampler no longer touches the stream owned by the writer
+    tracer->SetAveragingPeriod(tracer->m_period);
+  }
 }
 
 Ptr<CsTracer>
@@ -177,6 +193,7 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -190,12 +207,27 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
   , m_os(os)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
+  if (m_nodePtr == 0) {
+    // node is specified by its ID
+    uint32_t id = 0;
+    if (!boost::conversion::try_lexical_convert(node, id) || id >= NodeList::GetNNodes()) {
+      NS_FATAL_ERROR("Node \"" << node << "\" is neither a name registered with Names nor an ID "
+                     "of an existing node");
+    }
+    m_nodePtr = NodeList::GetNode(id);
+  }
+
   Connect();
 }
 
-CsTracer::~CsTracer(){};
+CsTracer::~CsTracer()
+{
+  TracerSampler::Unregister(m_sampler);
+}
 
 void
 CsTracer::Connect()
@@ -204,6 +236,12 @@ CsTracer::Connect()
   cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
   cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
 
+  // only available for cs::Partitioned
+  cs->TraceConnectWithoutContext("PartitionCacheHits",
+                                 MakeCallback(&CsTracer::PartitionCacheHits, this));
+  cs->TraceConnectWithoutContext("PartitionCacheMisses",
+                                 MakeCallback(&CsTracer::PartitionCacheMisses, this));
+
   Reset();
 }
 
@@ -211,17 +249,21 @@ void
 CsTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
+  TracerSampler::Unregister(m_sampler);
+  m_sampler = TracerSampler::Register(m_period, m_writer != nullptr ? nullptr : m_os,
+                                      [this] (std::ostream& os) { PeriodicPrinter(os); });
 }
 
 void
-CsTracer::PeriodicPrinter()
+CsTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Print(*m_writer);
+  }
+  else {
+    Print(os);
+  }
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
 void
@@ -239,23 +281,52 @@ CsTracer::PrintHeader(std::ostream& os) const
      << "\t";
 }
 
+const TraceSchema&
+CsTracer::GetSchema()
+{
+  static const TraceSchema schema = {
+    {"Time", TraceColumn::REAL},
+    {"Node", TraceColumn::STRING},
+    {"Type", TraceColumn::STRING},
+    {"Packets", TraceColumn::REAL},
+  };
+  return schema;
+}
+
 void
 CsTracer::Reset()
 {
   m_stats.Reset();
+  for (auto& partition : m_partitionStats) {
+    partition.second.Reset();
+  }
 }
 
 #define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+  writer.Write({time.ToDouble(Time::S), m_node, printName, m_stats.fieldName});
 
 void
 CsTracer::Print(std::ostream& os) const
+{
+  TextTraceWriter writer(shared_ptr<std::ostream>(&os, [] (std::ostream*) {}), GetSchema());
+  Print(writer);
+}
+
+void
+CsTracer::Print(TraceWriter& writer) const
 {
   Time time = Simulator::Now();
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
+
+  for (const auto& partition : m_partitionStats) {
+    std::string prefix = partition.first.toUri();
+    writer.Write({time.ToDouble(Time::S), m_node, "CacheHits[" + prefix + "]",
+                  partition.second.m_cacheHits});
+    writer.Write({time.ToDouble(Time::S), m_node, "CacheMisses[" + prefix + "]",
+                  partition.second.m_cacheMisses});
+  }
 }
 
 void
@@ -270,5 +341,29 @@ CsTracer::CacheMisses(shared_ptr<const Interest>)
   m_stats.m_cacheMisses++;
 }
 
+cs::Stats&
+CsTracer::GetPartitionStats(const Name& partition)
+{
+  auto stats = m_partitionStats.find(partition);
+  if (stats == m_partitionStats.end()) {
+    stats = m_partitionStats.insert({partition, cs::Stats()}).first;
+    stats->second.Reset();
+  }
+  return stats->second;
+}
+
+void
+CsTracer::PartitionCacheHits(const Name& partition, shared_ptr<const Interest>,
+                             shared_ptr<const Data>)
+{
+  GetPartitionStats(partition).m_cacheHits++;
+}
+
+void
+CsTracer::PartitionCacheMisses(const Name& partition, shared_ptr<const Interest>)
+{
+  GetPartitionStats(partition).m_cacheMisses++;
+}
+
 } // namespace ndn
 } // namespace ns3
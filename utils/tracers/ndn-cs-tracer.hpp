@@ -21,6 +21,8 @@
 #define CCNX_CS_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-sampler.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -67,6 +69,7 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -74,7 +77,8 @@ public:
    *
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -83,6 +87,7 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -90,7 +95,8 @@ public:
    *
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -99,6 +105,7 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -106,7 +113,8 @@ public:
    *
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -168,6 +176,18 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as records
+   */
+  void
+  Print(TraceWriter& writer) const;
+
+  /**
+   * @brief Get columns of trace records (names match the header of text traces)
+   */
+  static const TraceSchema&
+  GetSchema();
+
 private:
   void
   Connect();
@@ -178,7 +198,20 @@ private:
   void
   CacheMisses(shared_ptr<const Interest>);
 
+  void
+  PartitionCacheHits(const Name& partition, shared_ptr<const Interest>, shared_ptr<const Data>);
+
+  void
+  PartitionCacheMisses(const Name& partition, shared_ptr<const Interest>);
+
+  cs::Stats&
+  GetPartitionStats(const Name& partition);
+
 private:
+  static void
+  InitializeOutput(const std::list<Ptr<CsTracer>>& tracers,
+                   shared_ptr<std::ostream> outputStream, TraceFormat format);
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -186,7 +219,7 @@ private:
   Reset();
 
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
 private:
   std::string m_node;
@@ -195,8 +228,10 @@ private:
   shared_ptr<std::ostream> m_os;
 
   Time m_period;
-  EventId m_printEvent;
+  TracerSampler::Id m_sampler;
+  shared_ptr<TraceWriter> m_writer; ///< @brief output of Install helpers, otherwise m_os is used
   cs::Stats m_stats;
+  std::map<Name, cs::Stats> m_partitionStats; ///< @brief stats of cs::Partitioned partitions
 };
 
 /**
@@ -24,8 +24,10 @@
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/ndn-virtual-payload.hpp"
 
 #include "daemon/table/pit-entry.hpp"
 
@@ -47,7 +49,8 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         TraceFormat format /* = TraceFormat::TEXT*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
@@ -71,18 +74,15 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -109,18 +109,15 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  InitializeOutput(tracers, outputStream, format);
 
   g_tracers.push_back(std::make_tuple(outputStream, tracers));
 }
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -145,13 +142,32 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  InitializeOutput(tracers, outputStream, format);
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+L3RateTracer::InitializeOutput(const std::list<Ptr<L3RateTracer>>& tracers,
+                               shared_ptr<std::ostream> outputStream, TraceFormat format)
+{
+  if (tracers.empty())
+    return;
+
+  if (format == TraceFormat::TEXT) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  // records are formatted and written out by a background thread
+  auto writer = make_shared<AsyncTraceWriter>(TraceWriter::Create(format, outputStream,
+                                                                  GetSchema()));
+  for (const auto& tracer : tracers) {
+    tracer->m_writer = writer;
+    // register again, so that the sampler no longer touches the stream owned by the writer
+    tracer->SetAveragingPeriod(tracer->m_period);
+  }
 }
 
 Ptr<L3RateTracer>
@@ -169,6 +185,7 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -176,30 +193,35 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_sampler(TracerSampler::INVALID_ID)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::~L3RateTracer()
 {
-  m_printEvent.Cancel();
+  TracerSampler::Unregister(m_sampler);
 }
 
 void
 L3RateTracer::SetAveragingPeriod(const Time& period)
 {
   m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
+  TracerSampler::Unregister(m_sampler);
+  m_sampler = TracerSampler::Register(m_period, m_writer != nullptr ? nullptr : m_os,
+                                      [this] (std::ostream& os) { PeriodicPrinter(os); });
 }
 
 void
-L3RateTracer::PeriodicPrinter()
+L3RateTracer::PeriodicPrinter(std::ostream& os)
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Print(*m_writer);
+  }
+  else {
+    Print(os);
+  }
   Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
 void
@@ -226,47 +248,66 @@ L3RateTracer::PrintHeader(std::ostream& os) const
      << "KilobytesRaw";
 }
 
+const TraceSchema&
+L3RateTracer::GetSchema()
+{
+  static const TraceSchema schema = {
+    {"Time", TraceColumn::REAL},
+    {"Node", TraceColumn::STRING},
+    {"FaceId", TraceColumn::INTEGER},
+    {"FaceDescr", TraceColumn::STRING},
+    {"Type", TraceColumn::STRING},
+    {"Packets", TraceColumn::REAL},
+    {"Kilobytes", TraceColumn::REAL},
+    {"PacketRaw", TraceColumn::REAL},
+    {"KilobytesRaw", TraceColumn::REAL},
+  };
+  return schema;
+}
+
 void
 L3RateTracer::Reset()
 {
   for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+    stats.packets.Reset();
+    stats.bytes.Reset();
   }
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
 #define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
+  stats.packetRate.fieldName = /*new value*/ alpha * stats.packets.fieldName / period              \
+                               + /*old value*/ (1 - alpha) * stats.packetRate.fieldName;           \
+  stats.kilobyteRate.fieldName = /*new value*/ alpha * stats.bytes.fieldName / period / 1024.0     \
+                                 + /*old value*/ (1 - alpha) * stats.kilobyteRate.fieldName;       \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  writer.Write({time.ToDouble(Time::S), m_node,                                                    \
+                faceId != nfd::face::INVALID_FACEID ? static_cast<int64_t>(faceId) : -1,           \
+                faceId != nfd::face::INVALID_FACEID ? stats.info.c_str() : "all", printName,       \
+                stats.packetRate.fieldName, stats.kilobyteRate.fieldName,                          \
+                static_cast<double>(stats.packets.fieldName), stats.bytes.fieldName / 1024.0});
 
 void
 L3RateTracer::Print(std::ostream& os) const
+{
+  TextTraceWriter writer(shared_ptr<std::ostream>(&os, [] (std::ostream*) {}), GetSchema());
+  Print(writer);
+}
+
+void
+L3RateTracer::Print(TraceWriter& writer) const
 {
   Time time = Simulator::Now();
+  double period = m_period.ToDouble(Time::S);
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
+  // walking slots by face ID keeps the output ordered by face ID
+  for (nfd::FaceId faceId = 0; faceId < m_slots.size(); ++faceId) {
+    if (faceId == nfd::face::INVALID_FACEID || m_slots[faceId] == 0)
       continue;
 
+    FaceStats& stats = m_stats[m_slots[faceId] - 1];
+
     PRINTER("InInterests", m_inInterests);
     PRINTER("OutInterests", m_outInterests);
 
@@ -284,9 +325,9 @@ L3RateTracer::Print(std::ostream& os) const
   }
 
   {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
+    nfd::FaceId faceId = nfd::face::INVALID_FACEID;
+    if (faceId < m_slots.size() && m_slots[faceId] != 0) {
+      FaceStats& stats = m_stats[m_slots[faceId] - 1];
       PRINTER("SatisfiedInterests", m_satisfiedInterests);
       PRINTER("TimedOutInterests", m_timedOutInterests);
     }
@@ -296,109 +337,110 @@ L3RateTracer::Print(std::ostream& os) const
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    stats.bytes.m_outData += VirtualPayload::GetEncodedSize(data);
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    stats.bytes.m_inData += VirtualPayload::GetEncodedSize(data);
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_outNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_outNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetStats(face.getId(), &face);
+  stats.packets.m_inNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_inNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  GetStats(nfd::face::INVALID_FACEID).packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    GetStats(in.getFace().getId(), &in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    GetStats(out.getFace().getId(), &out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  GetStats(nfd::face::INVALID_FACEID).packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    GetStats(in.getFace().getId(), &in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    GetStats(out.getFace().getId(), &out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
-void
-L3RateTracer::AddInfo(const Face& face)
+L3RateTracer::FaceStats&
+L3RateTracer::GetStats(nfd::FaceId faceId, const Face* face)
 {
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  if (faceId >= m_slots.size()) {
+    m_slots.resize(faceId + 1, 0);
   }
+
+  uint32_t& slot = m_slots[faceId];
+  if (slot == 0) {
+    m_stats.emplace_back();
+    if (face != nullptr) {
+      m_stats.back().info = boost::lexical_cast<std::string>(face->getLocalUri());
+    }
+    slot = m_stats.size();
+  }
+
+  return m_stats[slot - 1];
 }
 
 } // namespace ndn
@@ -21,6 +21,8 @@
 #define CCNX_RATE_L3_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-sampler.hpp"
 
 #include "ndn-l3-tracer.hpp"
 
@@ -29,8 +31,8 @@
 #include "ns3/node-container.h"
 
 #include <tuple>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -48,9 +50,11 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +63,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +76,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Output format, binary traces can be converted to text by BinaryTraceReader
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -125,6 +133,18 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as records
+   */
+  void
+  Print(TraceWriter& writer) const;
+
+  /**
+   * @brief Get columns of trace records (names match the header of text traces)
+   */
+  static const TraceSchema&
+  GetSchema();
+
 protected:
   // from L3Tracer
   virtual void
@@ -152,25 +172,57 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  static void
+  InitializeOutput(const std::list<Ptr<L3RateTracer>>& tracers,
+                   shared_ptr<std::ostream> outputStream, TraceFormat format);
+
   void
   SetAveragingPeriod(const Time& period);
 
   void
-  PeriodicPrinter();
+  PeriodicPrinter(std::ostream& os);
 
   void
   Reset();
 
-  void
-  AddInfo(const Face& face);
+  struct FaceStats;
+
+  /**
+   * @brief Get stats of the face, creating them on first use
+   * @param faceId  face ID, or nfd::face::INVALID_FACEID for the node totals
+   * @param face    the face, used to record its description when stats are created
+   */
+  FaceStats&
+  GetStats(nfd::FaceId faceId, const Face* face = nullptr);
 
 private:
   shared_ptr<std::ostream> m_os;
   Time m_period;
-  EventId m_printEvent;
-
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  TracerSampler::Id m_sampler;
+  shared_ptr<TraceWriter> m_writer; ///< @brief output of Install helpers, otherwise m_os is used
+
+  struct FaceStats {
+    FaceStats()
+    {
+      packets.Reset();
+      bytes.Reset();
+      packetRate.Reset();
+      kilobyteRate.Reset();
+    }
+
+    std::string info; // needed, because face may no longer exist at the time of stat printing
+
+    Counters packets; ///< @brief packets within the current averaging period
+    Counters bytes;   ///< @brief bytes within the current averaging period
+
+    Stats packetRate;   ///< @brief smoothed rate, updated when printing
+    Stats kilobyteRate; ///< @brief smoothed rate, updated when printing
+  };
+
+  /// @brief stats of faces in the order of their first use
+  mutable std::vector<FaceStats> m_stats;
+  /// @brief slot in m_stats plus one (zero if the face is not seen yet), indexed by face ID
+  std::vector<uint32_t> m_slots;
 };
 
 } // namespace ndn
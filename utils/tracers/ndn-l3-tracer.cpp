@@ -22,7 +22,9 @@
 #include "ns3/packet.h"
 #include "ns3/config.h"
 #include "ns3/names.h"
+#include "ns3/node-list.h"
 #include "ns3/callback.h"
+#include "ns3/abort.h"
 
 #include <boost/lexical_cast.hpp>
 
@@ -46,7 +48,18 @@ L3Tracer::L3Tracer(Ptr<Node> node)
 
 L3Tracer::L3Tracer(const std::string& node)
   : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
 {
+  if (m_nodePtr == 0) {
+    // node is specified by its ID
+    uint32_t id = 0;
+    if (!boost::conversion::try_lexical_convert(node, id) || id >= NodeList::GetNNodes()) {
+      NS_FATAL_ERROR("Node \"" << node << "\" is neither a name registered with Names nor an ID "
+                     "of an existing node");
+    }
+    m_nodePtr = NodeList::GetNode(id);
+  }
+
   Connect();
 }
 
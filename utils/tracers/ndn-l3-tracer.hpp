@@ -104,7 +104,14 @@ protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  struct Stats {
+  /**
+   * @brief Set of per-face counters
+   *
+   * Integer instantiation (Counters) is used to count packets and bytes on the forwarding path,
+   * floating point one (Stats) to keep rates derived from the counters
+   */
+  template<typename T>
+  struct BasicStats {
     inline void
     Reset()
     {
@@ -121,17 +128,20 @@ protected:
       m_outTimedOutInterests = 0;
     }
 
-    double m_inInterests;
-    double m_outInterests;
-    double m_inData;
-    double m_outData;
-    double m_inNack;
-    double m_outNack;
-    double m_satisfiedInterests;
-    double m_timedOutInterests;
-    double m_outSatisfiedInterests;
-    double m_outTimedOutInterests;
+    T m_inInterests;
+    T m_outInterests;
+    T m_inData;
+    T m_outData;
+    T m_inNack;
+    T m_outNack;
+    T m_satisfiedInterests;
+    T m_timedOutInterests;
+    T m_outSatisfiedInterests;
+    T m_outTimedOutInterests;
   };
+
+  typedef BasicStats<double> Stats;
+  typedef BasicStats<uint64_t> Counters;
 };
 
 /**
@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-reader.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/read.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceReader");
+
+namespace ns3 {
+namespace ndn {
+
+static const char TRACE_MAGIC[8] = {'n', 'd', 'n', 'S', 'I', 'M', 't', 'r'};
+
+static uint32_t
+decodeUint32(const char* wire)
+{
+  const unsigned char* buf = reinterpret_cast<const unsigned char*>(wire);
+  return static_cast<uint32_t>(buf[0]) | (static_cast<uint32_t>(buf[1]) << 8)
+         | (static_cast<uint32_t>(buf[2]) << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+static uint64_t
+decodeUint64(const char* wire)
+{
+  return static_cast<uint64_t>(decodeUint32(wire))
+         | (static_cast<uint64_t>(decodeUint32(wire + 4)) << 32);
+}
+
+static uint32_t
+readUint32(std::istream& is)
+{
+  char buf[4] = {0, 0, 0, 0};
+  is.read(buf, sizeof(buf));
+  return decodeUint32(buf);
+}
+
+/**
+ * @brief Read string of @p size bytes
+ *
+ * The string grows only as data is read, so a corrupted size cannot cause a huge allocation.
+ *
+ * @return false if the stream ends before @p size bytes are read
+ */
+static bool
+readString(std::istream& is, uint32_t size, std::string& str)
+{
+  const size_t chunkSize = 64 * 1024;
+
+  str.clear();
+  while (is && str.size() < size) {
+    size_t offset = str.size();
+    str.resize(offset + std::min<size_t>(chunkSize, size - offset));
+    is.read(&str[offset], str.size() - offset);
+  }
+  return static_cast<bool>(is);
+}
+
+static size_t
+getValueSize(TraceColumn::Type type)
+{
+  return type == TraceColumn::STRING ? sizeof(uint32_t) : sizeof(uint64_t);
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+  , m_isCompressed(false)
+  , m_nRecords(0)
+  , m_record(0)
+{
+  char magic[sizeof(TRACE_MAGIC)];
+  m_is.read(magic, sizeof(magic));
+  if (!m_is || !std::equal(magic, magic + sizeof(magic), TRACE_MAGIC)) {
+    NS_FATAL_ERROR("Stream does not contain a binary trace");
+  }
+
+  uint32_t version = readUint32(m_is);
+  if (version != BinaryTraceWriter::VERSION) {
+    NS_FATAL_ERROR("Unsupported version " << version << " of binary trace");
+  }
+
+  m_isCompressed = readUint32(m_is) != 0;
+
+  uint32_t nColumns = readUint32(m_is);
+  for (uint32_t i = 0; i < nColumns && m_is; i++) {
+    TraceColumn column;
+    column.type = static_cast<TraceColumn::Type>(m_is.get());
+    if (column.type != TraceColumn::REAL && column.type != TraceColumn::INTEGER
+        && column.type != TraceColumn::STRING) {
+      NS_FATAL_ERROR("Unknown type of column " << i << " in binary trace");
+    }
+    uint32_t nameSize = readUint32(m_is);
+    if (!m_is || !readString(m_is, nameSize, column.name))
+      break;
+    m_schema.push_back(column);
+  }
+
+  if (!m_is) {
+    NS_FATAL_ERROR("Binary trace header is truncated");
+  }
+
+  m_offsets.resize(m_schema.size());
+}
+
+bool
+BinaryTraceReader::Next()
+{
+  if (m_record < m_nRecords) {
+    ++m_record;
+    return true;
+  }
+
+  // skip empty blocks, if any
+  while (ReadBlock()) {
+    if (m_nRecords > 0) {
+      m_record = 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+  m_nRecords = 0;
+  m_record = 0;
+
+  uint32_t nRecords = readUint32(m_is);
+  if (m_is.eof()) {
+    return false;
+  }
+
+  size_t offset = 0;
+  for (size_t i = 0; i < m_schema.size(); i++) {
+    m_offsets[i] = offset;
+    offset += nRecords * getValueSize(m_schema[i].type);
+  }
+
+  uint32_t nNewStrings = readUint32(m_is);
+  for (uint32_t i = 0; i < nNewStrings && m_is; i++) {
+    std::string str;
+    uint32_t size = readUint32(m_is);
+    if (m_is && readString(m_is, size, str))
+      m_dictionary.push_back(std::move(str));
+  }
+
+  uint32_t payloadSize = readUint32(m_is);
+  if (m_is && !m_isCompressed && payloadSize != offset) {
+    NS_FATAL_ERROR("Binary trace block is corrupted");
+  }
+
+  std::string payload;
+  if (!m_is || !readString(m_is, payloadSize, payload)) {
+    NS_FATAL_ERROR("Binary trace is truncated");
+  }
+
+  if (m_isCompressed) {
+    namespace io = boost::iostreams;
+    m_payload.clear();
+    try {
+      io::filtering_istream decompressor;
+      decompressor.push(io::zlib_decompressor());
+      decompressor.push(io::array_source(payload.data(), payload.size()));
+
+      // no more than the expected size is decompressed, the excess means a corrupted block
+      char chunk[4096];
+      std::streamsize size;
+      while (m_payload.size() <= offset
+             && (size = io::read(decompressor, chunk, sizeof(chunk))) > 0) {
+        m_payload.append(chunk, static_cast<size_t>(size));
+      }
+    }
+    catch (const io::zlib_error& e) {
+      NS_FATAL_ERROR("Binary trace block cannot be decompressed: " << e.what());
+    }
+  }
+  else {
+    m_payload.swap(payload);
+  }
+
+  if (offset != m_payload.size()) {
+    NS_FATAL_ERROR("Binary trace block is corrupted");
+  }
+
+  m_nRecords = nRecords;
+  return true;
+}
+
+const char*
+BinaryTraceReader::GetValue(size_t column) const
+{
+  NS_ASSERT(m_record > 0 && column < m_schema.size());
+  return m_payload.data() + m_offsets[column]
+         + (m_record - 1) * getValueSize(m_schema[column].type);
+}
+
+double
+BinaryTraceReader::GetReal(size_t column) const
+{
+  NS_ASSERT(m_schema[column].type == TraceColumn::REAL);
+  uint64_t bits = decodeUint64(GetValue(column));
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+int64_t
+BinaryTraceReader::GetInteger(size_t column) const
+{
+  NS_ASSERT(m_schema[column].type == TraceColumn::INTEGER);
+  return static_cast<int64_t>(decodeUint64(GetValue(column)));
+}
+
+const std::string&
+BinaryTraceReader::GetString(size_t column) const
+{
+  NS_ASSERT(m_schema[column].type == TraceColumn::STRING);
+  uint32_t index = decodeUint32(GetValue(column));
+  if (index >= m_dictionary.size()) {
+    NS_FATAL_ERROR("Binary trace refers to unknown string " << index);
+  }
+  return m_dictionary[index];
+}
+
+void
+BinaryTraceReader::PrintHeader(std::ostream& os) const
+{
+  for (size_t i = 0; i < m_schema.size(); i++) {
+    os << (i > 0 ? "\t" : "") << m_schema[i].name;
+  }
+}
+
+void
+BinaryTraceReader::PrintRecord(std::ostream& os) const
+{
+  for (size_t i = 0; i < m_schema.size(); i++) {
+    if (i > 0) {
+      os << "\t";
+    }
+
+    switch (m_schema[i].type) {
+    case TraceColumn::REAL:
+      os << GetReal(i);
+      break;
+    case TraceColumn::INTEGER:
+      os << GetInteger(i);
+      break;
+    case TraceColumn::STRING:
+      os << GetString(i);
+      break;
+    }
+  }
+  os << "\n";
+}
+
+uint64_t
+BinaryTraceReader::ConvertToText(std::istream& is, std::ostream& os)
+{
+  BinaryTraceReader reader(is);
+  reader.PrintHeader(os);
+  os << "\n";
+
+  uint64_t nRecords = 0;
+  while (reader.Next()) {
+    reader.PrintRecord(os);
+    ++nRecords;
+  }
+
+  NS_LOG_INFO("Converted " << nRecords << " records");
+  return nRecords;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_READER_HPP
+#define NDN_TRACE_READER_HPP
+
+#include "ndn-trace-writer.hpp"
+
+#include <istream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming reader of traces written by BinaryTraceWriter
+ *
+ * Only one block of records is kept in memory at a time:
+ *
+ *     BinaryTraceReader reader(is);
+ *     while (reader.Next()) {
+ *       double time = reader.GetReal(0);
+ *       ...
+ *     }
+ */
+class BinaryTraceReader {
+public:
+  /**
+   * @brief Read trace header from @p is
+   *
+   * Terminates the simulation if the stream does not contain a binary trace
+   */
+  explicit
+  BinaryTraceReader(std::istream& is);
+
+  const TraceSchema&
+  GetSchema() const
+  {
+    return m_schema;
+  }
+
+  /**
+   * @brief Advance to the next record
+   * @returns false if there are no more records
+   */
+  bool
+  Next();
+
+  double
+  GetReal(size_t column) const;
+
+  int64_t
+  GetInteger(size_t column) const;
+
+  const std::string&
+  GetString(size_t column) const;
+
+  /**
+   * @brief Print header line in the text layout of trace helpers
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print current record in the text layout of trace helpers
+   */
+  void
+  PrintRecord(std::ostream& os) const;
+
+  /**
+   * @brief Convert binary trace from @p is into text trace in @p os
+   * @returns number of converted records
+   */
+  static uint64_t
+  ConvertToText(std::istream& is, std::ostream& os);
+
+private:
+  bool
+  ReadBlock();
+
+  const char*
+  GetValue(size_t column) const;
+
+private:
+  std::istream& m_is;
+  bool m_isCompressed;
+  TraceSchema m_schema;
+  std::vector<size_t> m_offsets; ///< @brief offset of each column in the block payload
+  std::vector<std::string> m_dictionary;
+
+  std::string m_payload;
+  uint32_t m_nRecords;
+  uint32_t m_record; ///< @brief current record in the block plus one
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_READER_HPP
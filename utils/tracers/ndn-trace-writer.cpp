@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-writer.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <cstring>
+#include <ostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+static const char TRACE_MAGIC[8] = {'n', 'd', 'n', 'S', 'I', 'M', 't', 'r'};
+
+static void
+appendUint32(std::string& buffer, uint32_t value)
+{
+  char buf[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                 static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)};
+  buffer.append(buf, sizeof(buf));
+}
+
+static void
+appendUint64(std::string& buffer, uint64_t value)
+{
+  appendUint32(buffer, static_cast<uint32_t>(value & 0xFFFFFFFF));
+  appendUint32(buffer, static_cast<uint32_t>(value >> 32));
+}
+
+shared_ptr<TraceWriter>
+TraceWriter::Create(TraceFormat format, shared_ptr<std::ostream> os, const TraceSchema& schema)
+{
+  switch (format) {
+  case TraceFormat::TEXT:
+    return make_shared<TextTraceWriter>(os, schema);
+  case TraceFormat::BINARY:
+    return make_shared<BinaryTraceWriter>(os, schema);
+  }
+  return nullptr;
+}
+
+TraceWriter::TraceWriter(shared_ptr<std::ostream> os, const TraceSchema& schema)
+  : m_os(os)
+  , m_schema(schema)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+}
+
+void
+TraceWriter::Flush()
+{
+  m_os->flush();
+}
+
+void
+TextTraceWriter::Write(const TraceValue* record, size_t size)
+{
+  NS_ASSERT(size == m_schema.size());
+
+  std::ostream& os = *m_os;
+  for (size_t i = 0; i < size; ++i) {
+    if (i > 0) {
+      os << "\t";
+    }
+
+    switch (m_schema[i].type) {
+    case TraceColumn::REAL:
+      os << record[i].real;
+      break;
+    case TraceColumn::INTEGER:
+      os << record[i].integer;
+      break;
+    case TraceColumn::STRING:
+      os << record[i].string;
+      break;
+    }
+  }
+  os << "\n";
+}
+
+BinaryTraceWriter::BinaryTraceWriter(shared_ptr<std::ostream> os, const TraceSchema& schema,
+                                     bool isCompressed)
+  : TraceWriter(os, schema)
+  , m_isCompressed(isCompressed)
+  , m_nRecords(0)
+  , m_columns(schema.size())
+{
+  std::string header(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  appendUint32(header, VERSION);
+  appendUint32(header, m_isCompressed ? 1 : 0);
+  appendUint32(header, m_schema.size());
+  for (const auto& column : m_schema) {
+    header.push_back(static_cast<char>(column.type));
+    appendUint32(header, column.name.size());
+    header.append(column.name);
+  }
+  m_os->write(header.data(), header.size());
+
+  for (auto& column : m_columns) {
+    column.reserve(BLOCK_SIZE * sizeof(uint64_t));
+  }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+  Flush();
+}
+
+void
+BinaryTraceWriter::Write(const TraceValue* record, size_t size)
+{
+  NS_ASSERT(size == m_schema.size());
+
+  for (size_t i = 0; i < size; ++i) {
+    switch (m_schema[i].type) {
+    case TraceColumn::REAL: {
+      uint64_t bits;
+      std::memcpy(&bits, &record[i].real, sizeof(bits));
+      appendUint64(m_columns[i], bits);
+      break;
+    }
+    case TraceColumn::INTEGER:
+      appendUint64(m_columns[i], static_cast<uint64_t>(record[i].integer));
+      break;
+    case TraceColumn::STRING:
+      appendUint32(m_columns[i], Intern(record[i].string));
+      break;
+    }
+  }
+
+  if (++m_nRecords == BLOCK_SIZE) {
+    WriteBlock();
+  }
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+  if (m_nRecords > 0) {
+    WriteBlock();
+  }
+  TraceWriter::Flush();
+}
+
+uint32_t
+BinaryTraceWriter::Intern(const char* value)
+{
+  auto entry = m_dictionary.emplace(value, m_dictionary.size());
+  if (entry.second) {
+    m_newStrings.push_back(&entry.first->first);
+  }
+  return entry.first->second;
+}
+
+void
+BinaryTraceWriter::WriteBlock()
+{
+  std::string header;
+  appendUint32(header, m_nRecords);
+  appendUint32(header, m_newStrings.size());
+  for (const std::string* str : m_newStrings) {
+    appendUint32(header, str->size());
+    header.append(*str);
+  }
+
+  std::string payload;
+  if (m_isCompressed) {
+    namespace io = boost::iostreams;
+    io::filtering_ostream compressor;
+    compressor.push(io::zlib_compressor(io::zlib::best_speed));
+    compressor.push(io::back_inserter(payload));
+    for (const auto& column : m_columns) {
+      compressor.write(column.data(), column.size());
+    }
+    compressor.reset(); // completes the compressed stream
+  }
+  else {
+    for (const auto& column : m_columns) {
+      payload.append(column);
+    }
+  }
+  appendUint32(header, payload.size());
+
+  m_os->write(header.data(), header.size());
+  m_os->write(payload.data(), payload.size());
+
+  // no logging here: blocks can be written from AsyncTraceWriter's thread
+
+  m_nRecords = 0;
+  m_newStrings.clear();
+  for (auto& column : m_columns) {
+    column.clear();
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_WRITER_HPP
+#define NDN_TRACE_WRITER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output format of trace helpers
+ */
+enum class TraceFormat {
+  TEXT,  ///< tab-separated values, one record per line
+  BINARY ///< fixed-width columnar records in compressed blocks (see BinaryTraceWriter)
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column of a trace record
+ */
+struct TraceColumn {
+  enum Type : uint8_t {
+    REAL = 1,    ///< double
+    INTEGER = 2, ///< signed 64-bit integer
+    STRING = 3   ///< string (stored as index in string dictionary in binary traces)
+  };
+
+  std::string name;
+  Type type;
+};
+
+typedef std::vector<TraceColumn> TraceSchema;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Value of a trace record column, interpreted according to the column type
+ *
+ * String values are not copied and must remain valid until TraceWriter::Write returns.
+ */
+union TraceValue {
+  TraceValue()
+    : integer(0)
+  {
+  }
+
+  TraceValue(double value)
+    : real(value)
+  {
+  }
+
+  TraceValue(int32_t value)
+    : integer(value)
+  {
+  }
+
+  TraceValue(uint32_t value)
+    : integer(value)
+  {
+  }
+
+  TraceValue(int64_t value)
+    : integer(value)
+  {
+  }
+
+  TraceValue(uint64_t value)
+    : integer(static_cast<int64_t>(value))
+  {
+  }
+
+  TraceValue(const char* value)
+    : string(value)
+  {
+  }
+
+  TraceValue(const std::string& value)
+    : string(value.c_str())
+  {
+  }
+
+  double real;
+  int64_t integer;
+  const char* string;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Base class for writers of trace records
+ */
+class TraceWriter {
+public:
+  /**
+   * @brief Create writer of the specified format
+   * @param format  output format
+   * @param os      output stream; writer keeps it alive until destroyed
+   * @param schema  columns of the records
+   */
+  static shared_ptr<TraceWriter>
+  Create(TraceFormat format, shared_ptr<std::ostream> os, const TraceSchema& schema);
+
+  TraceWriter(shared_ptr<std::ostream> os, const TraceSchema& schema);
+
+  virtual
+  ~TraceWriter();
+
+  /**
+   * @brief Write one record, values must be in the order of schema columns
+   */
+  void
+  Write(std::initializer_list<TraceValue> record)
+  {
+    Write(record.begin(), record.size());
+  }
+
+  virtual void
+  Write(const TraceValue* record, size_t size) = 0;
+
+  /**
+   * @brief Write out buffered records
+   */
+  virtual void
+  Flush();
+
+  const TraceSchema&
+  GetSchema() const
+  {
+    return m_schema;
+  }
+
+protected:
+  shared_ptr<std::ostream> m_os;
+  TraceSchema m_schema;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of tab-separated text records (the classic trace layout)
+ */
+class TextTraceWriter : public TraceWriter {
+public:
+  using TraceWriter::TraceWriter;
+  using TraceWriter::Write;
+
+  virtual void
+  Write(const TraceValue* record, size_t size) override;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of binary columnar traces
+ *
+ * The file starts with a header (all integers are little-endian):
+ *
+ *     "ndnSIMtr" magic, uint32 version, uint32 compression (0 = none, 1 = zlib),
+ *     uint32 number of columns, for each column: uint8 type, uint32 name length, name
+ *
+ * followed by blocks of up to BLOCK_SIZE records:
+ *
+ *     uint32 number of records,
+ *     uint32 number of new dictionary strings, for each: uint32 length, string,
+ *     uint32 payload size, payload (compressed unless compression is 0)
+ *
+ * The payload stores values column by column, 8 bytes per REAL (IEEE 754) or INTEGER value and
+ * 4 bytes (index in the string dictionary accumulated over preceding blocks) per STRING value.
+ *
+ * @sa BinaryTraceReader
+ */
+class BinaryTraceWriter : public TraceWriter {
+public:
+  static const uint32_t VERSION = 1;
+  static const uint32_t BLOCK_SIZE = 4096;
+
+  BinaryTraceWriter(shared_ptr<std::ostream> os, const TraceSchema& schema,
+                    bool isCompressed = true);
+
+  ~BinaryTraceWriter();
+
+  using TraceWriter::Write;
+
+  virtual void
+  Write(const TraceValue* record, size_t size) override;
+
+  virtual void
+  Flush() override;
+
+private:
+  uint32_t
+  Intern(const char* value);
+
+  void
+  WriteBlock();
+
+private:
+  bool m_isCompressed;
+  uint32_t m_nRecords;
+  std::vector<std::string> m_columns; ///< @brief column data of the current block
+
+  std::unordered_map<std::string, uint32_t> m_dictionary;
+  std::vector<const std::string*> m_newStrings; ///< @brief strings added in the current block
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_WRITER_HPP
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tracer-sampler.hpp"
+#include "../ndn-event-accounting.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/event-id.h"
+#include "ns3/log.h"
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TracerSampler");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct Registration {
+  TracerSampler::Id id;
+  shared_ptr<std::ostream> os;
+  TracerSampler::SampleCallback sample;
+};
+
+struct Group {
+  EventId event;
+  std::list<Registration> registrations;
+};
+
+// (period, phase) of the sampling events
+typedef std::pair<Time, Time> GroupKey;
+
+std::map<GroupKey, Group> g_groups;
+std::unordered_map<TracerSampler::Id, std::pair<GroupKey, std::list<Registration>::iterator>>
+  g_registrations;
+TracerSampler::Id g_lastId = TracerSampler::INVALID_ID;
+bool g_isDestroyScheduled = false;
+
+} // namespace
+
+TracerSampler::Id
+TracerSampler::Register(Time period, shared_ptr<std::ostream> os, const SampleCallback& sample)
+{
+  NS_ASSERT_MSG(period.IsStrictlyPositive(), "Sampling period must be positive");
+
+  if (!g_isDestroyScheduled) {
+    // events do not survive Simulator::Destroy, neither should groups
+    Simulator::ScheduleDestroy(&TracerSampler::Clear);
+    g_isDestroyScheduled = true;
+  }
+
+  Time phase = TimeStep(Simulator::Now().GetTimeStep() % period.GetTimeStep());
+  GroupKey key(period, phase);
+
+  Group& group = g_groups[key];
+  if (group.registrations.empty()) {
+    group.event = EventAccounting::Schedule(EventAccounting::TRACER, period,
+                                          &TracerSampler::Sample, period, phase);
+  }
+
+  Id id = ++g_lastId;
+  group.registrations.push_back(Registration{id, os, sample});
+  g_registrations.emplace(id, std::make_pair(key, std::prev(group.registrations.end())));
+
+  return id;
+}
+
+void
+TracerSampler::Unregister(Id id)
+{
+  auto registration = g_registrations.find(id);
+  if (registration == g_registrations.end())
+    return;
+
+  auto group = g_groups.find(registration->second.first);
+  group->second.registrations.erase(registration->second.second);
+  g_registrations.erase(registration);
+
+  if (group->second.registrations.empty()) {
+    group->second.event.Cancel();
+    g_groups.erase(group);
+  }
+}
+
+size_t
+TracerSampler::GetNEvents()
+{
+  return g_groups.size();
+}
+
+void
+TracerSampler::Sample(Time period, Time phase)
+{
+  auto group = g_groups.find(GroupKey(period, phase));
+  NS_ASSERT(group != g_groups.end());
+
+  // output of all tracers writing to the same stream is buffered and written at once
+  std::map<std::ostream*, std::ostringstream> buffers;
+  for (const auto& registration : group->second.registrations) {
+    auto buffer = buffers.find(registration.os.get());
+    if (buffer == buffers.end()) {
+      buffer = buffers.emplace(registration.os.get(), std::ostringstream()).first;
+      if (registration.os != nullptr) {
+        buffer->second.copyfmt(*registration.os);
+      }
+    }
+    registration.sample(buffer->second);
+  }
+
+  for (const auto& buffer : buffers) {
+    if (buffer.first == nullptr)
+      continue;
+
+    const std::string& output = buffer.second.str();
+    buffer.first->write(output.data(), output.size());
+  }
+
+  NS_LOG_DEBUG("Sampled " << group->second.registrations.size() << " tracers");
+
+  group->second.event = EventAccounting::Schedule(EventAccounting::TRACER, period,
+                                          &TracerSampler::Sample, period, phase);
+}
+
+void
+TracerSampler::Clear()
+{
+  g_groups.clear();
+  g_registrations.clear();
+  g_isDestroyScheduled = false;
+}
+
+} // namespace ndn
+} // namespace ns3
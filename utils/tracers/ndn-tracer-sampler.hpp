@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACER_SAMPLER_HPP
+#define NDN_TRACER_SAMPLER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <functional>
+#include <iosfwd>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Periodic sampler shared by all instances of rate and CS tracers
+ *
+ * Instead of scheduling a print event per tracer (i.e., per node), tracers register a sample
+ * callback.  Tracers registered with the same period at the same phase share a single event,
+ * which calls the callbacks in the order of registration and writes output of all tracers that
+ * share an output stream in one pass.  Output is the same as with per-tracer events.
+ */
+class TracerSampler {
+public:
+  typedef uint64_t Id;
+  typedef std::function<void(std::ostream&)> SampleCallback;
+
+  static const Id INVALID_ID = 0;
+
+  /**
+   * @brief Register @p sample to be called every @p period, starting one period from now
+   *
+   * @param period  sampling period
+   * @param os      stream to which output of the callback is eventually written, or nullptr if
+   *                the callback writes elsewhere (e.g., into an AsyncTraceWriter, whose stream
+   *                belongs to the background thread and must not be touched by the sampler)
+   * @param sample  callback that writes the sample into the provided (buffer) stream
+   *
+   * @returns registration ID to be used with Unregister
+   */
+  static Id
+  Register(Time period, shared_ptr<std::ostream> os, const SampleCallback& sample);
+
+  /**
+   * @brief Stop calling the callback registered with @p id
+   *
+   * Unknown or invalid IDs are ignored
+   */
+  static void
+  Unregister(Id id);
+
+  /**
+   * @brief Get number of scheduled sampling events (for testing)
+   */
+  static size_t
+  GetNEvents();
+
+private:
+  static void
+  Sample(Time period, Time phase);
+
+  static void
+  Clear();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACER_SAMPLER_HPP
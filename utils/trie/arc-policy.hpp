@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/ghost-list.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache (ARC) policy (Megiddo & Modha, FAST'03)
+ *
+ * Cached entries are split between T1 (seen once recently) and T2 (seen at least twice recently),
+ * both in LRU order.  Keys of entries evicted from T1 and T2 are remembered in B1 and B2
+ * histories, and hits in these histories adapt the target size of T1.  Entries of a sequential
+ * scan stay in T1 and cannot flush the frequently used entries from T2.
+ *
+ * All cached entries are kept in a single list: T1 followed by T2, each least recently used first.
+ */
+struct arc_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Arc";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    bool frequent;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static bool&
+    frequent(typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+        ->frequent;
+    }
+
+    // could be just typedef
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to frequent methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , target_(0)
+        , recent_size_(0)
+        , frequent_begin_(policy_container::end())
+      {
+        set_max_size(max_size_);
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        lookup(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t key = detail::full_key_hash(item);
+
+        if (max_size_ == 0) {
+          // unlimited cache, nothing to adapt
+          push_recent(item);
+          return true;
+        }
+
+        bool wasSeen = true;
+        if (b1_.erase(key)) {
+          size_t delta = std::max<size_t>(b2_.size() / (b1_.size() + 1), 1);
+          target_ = std::min(max_size_, target_ + delta);
+          replace(false);
+        }
+        else if (b2_.erase(key)) {
+          size_t delta = std::max<size_t>(b1_.size() / (b2_.size() + 1), 1);
+          target_ = target_ > delta ? target_ - delta : 0;
+          replace(true);
+        }
+        else {
+          wasSeen = false;
+          if (recent_size_ + b1_.size() >= max_size_) {
+            if (recent_size_ < max_size_) {
+              b1_.pop_oldest();
+              replace(false);
+            }
+            else {
+              base_.erase(&(*policy_container::begin()));
+            }
+          }
+          else if (policy_container::size() + b1_.size() + b2_.size() >= max_size_) {
+            if (policy_container::size() + b1_.size() + b2_.size() >= 2 * max_size_) {
+              b2_.pop_oldest();
+            }
+            replace(false);
+          }
+        }
+
+        // more than one eviction is needed if max size has been reduced
+        while (policy_container::size() >= max_size_) {
+          replace(false);
+        }
+
+        if (wasSeen) {
+          push_frequent(item);
+        }
+        else {
+          push_recent(item);
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        // hit in either T1 or T2 moves the entry to the most recently used end of T2
+        remove(item);
+        push_frequent(item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        remove(item);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        recent_size_ = 0;
+        frequent_begin_ = policy_container::end();
+        target_ = 0;
+        b1_.clear();
+        b2_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        target_ = std::min(target_, max_size_);
+        b1_.set_capacity(max_size_);
+        b2_.set_capacity(max_size_);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      /**
+       * @brief Evict an entry from T1 or T2 (if the cache is full), remembering its key
+       */
+      void
+      replace(bool inB2)
+      {
+        if (policy_container::size() < max_size_)
+          return;
+
+        bool fromRecent = recent_size_ > 0
+                          && (recent_size_ > target_ || (inB2 && recent_size_ == target_)
+                              || frequent_begin_ == policy_container::end());
+
+        typename parent_trie::iterator victim =
+          fromRecent ? &(*policy_container::begin()) : &(*frequent_begin_);
+        (fromRecent ? b1_ : b2_).push(detail::full_key_hash(victim));
+        base_.erase(victim);
+      }
+
+      void
+      push_recent(typename parent_trie::iterator item)
+      {
+        frequent(item) = false;
+        policy_container::insert(frequent_begin_, *item);
+        recent_size_++;
+      }
+
+      void
+      push_frequent(typename parent_trie::iterator item)
+      {
+        frequent(item) = true;
+        policy_container::push_back(*item);
+        if (frequent_begin_ == policy_container::end()) {
+          frequent_begin_ = policy_container::s_iterator_to(*item);
+        }
+      }
+
+      void
+      remove(typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position == frequent_begin_) {
+          ++frequent_begin_;
+        }
+        if (!frequent(item)) {
+          recent_size_--;
+        }
+        policy_container::erase(position);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+
+      size_t target_; ///< @brief target size of T1 (p in the original paper)
+      size_t recent_size_; ///< @brief size of T1
+      typename policy_container::iterator frequent_begin_; ///< @brief first (LRU) entry of T2
+      detail::ghost_list b1_;
+      detail::ghost_list b2_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ARC_POLICY_H_
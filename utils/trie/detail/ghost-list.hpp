@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef GHOST_LIST_H_
+#define GHOST_LIST_H_
+
+/// @cond include_hidden
+
+#include <boost/functional/hash.hpp>
+
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Hash of the full key of the trie node (all components from the root to the node)
+ */
+template<class Trie>
+inline size_t
+full_key_hash(const Trie* item)
+{
+  size_t hash = 0;
+  for (; item->parent() != nullptr; item = item->parent()) {
+    boost::hash_combine(hash, boost::hash_value(item->key()));
+  }
+  return hash;
+}
+
+/**
+ * @brief Bounded LRU-ordered history of keys (hashes) that are no longer in the cache
+ *
+ * Used by replacement policies that adapt based on recently evicted entries (ARC, 2Q, S3-FIFO).
+ * When the capacity is reached, the oldest key is forgotten.
+ */
+class ghost_list {
+public:
+  ghost_list()
+    : capacity_(0)
+  {
+  }
+
+  void
+  set_capacity(size_t capacity)
+  {
+    capacity_ = capacity;
+    while (keys_.size() > capacity_) {
+      pop_oldest();
+    }
+  }
+
+  size_t
+  size() const
+  {
+    return keys_.size();
+  }
+
+  bool
+  contains(size_t key) const
+  {
+    return index_.find(key) != index_.end();
+  }
+
+  /**
+   * @brief Remember the key as the most recently evicted
+   */
+  void
+  push(size_t key)
+  {
+    if (capacity_ == 0)
+      return;
+
+    erase(key);
+    while (keys_.size() >= capacity_) {
+      pop_oldest();
+    }
+    index_[key] = keys_.insert(keys_.end(), key);
+  }
+
+  /**
+   * @brief Forget the key
+   * @returns true if the key was in the history
+   */
+  bool
+  erase(size_t key)
+  {
+    auto found = index_.find(key);
+    if (found == index_.end())
+      return false;
+
+    keys_.erase(found->second);
+    index_.erase(found);
+    return true;
+  }
+
+  void
+  pop_oldest()
+  {
+    if (keys_.empty())
+      return;
+
+    index_.erase(keys_.front());
+    keys_.pop_front();
+  }
+
+  void
+  clear()
+  {
+    keys_.clear();
+    index_.clear();
+  }
+
+private:
+  size_t capacity_;
+  std::list<size_t> keys_;
+  std::unordered_map<size_t, std::list<size_t>::iterator> index_;
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // GHOST_LIST_H_
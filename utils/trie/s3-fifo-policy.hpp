@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef S3_FIFO_POLICY_H_
+#define S3_FIFO_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/ghost-list.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for S3-FIFO replacement policy (Yang et al., SOSP'23)
+ *
+ * New entries go to the small FIFO queue S (10% of the cache).  When evicted from S, entries that
+ * were requested while in S are moved to the main FIFO queue M, while the rest are dropped and
+ * their keys remembered in the ghost queue G.  Entries that are requested again while in G are
+ * inserted directly into M.  M is managed as CLOCK with a 2-bit access counter.  One-hit wonders
+ * of a scan are therefore quickly dropped from S.
+ *
+ * All cached entries are kept in a single list: S followed by M, each oldest first.
+ */
+struct s3_fifo_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "S3Fifo";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    bool in_main;
+    uint8_t frequency;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    // could be just typedef
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , small_size_(0)
+        , main_begin_(policy_container::end())
+      {
+        ghost_.set_capacity(max_size_);
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        lookup(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        bool wasSeen = ghost_.erase(detail::full_key_hash(item));
+
+        if (max_size_ != 0) {
+          while (policy_container::size() >= max_size_) {
+            evict();
+          }
+        }
+
+        get_hook(item).frequency = 0;
+        if (wasSeen) {
+          push_main(item);
+        }
+        else {
+          get_hook(item).in_main = false;
+          policy_container::insert(main_begin_, *item);
+          small_size_++;
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        // no relocation, only mark the access
+        uint8_t& frequency = get_hook(item).frequency;
+        if (frequency < MAX_FREQUENCY) {
+          frequency++;
+        }
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        remove(item);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        small_size_ = 0;
+        main_begin_ = policy_container::end();
+        ghost_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        ghost_.set_capacity(max_size_);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      /**
+       * @brief Make one step of eviction: either drop an entry or move it within the queues
+       */
+      void
+      evict()
+      {
+        size_t maxSmallSize = std::max<size_t>(max_size_ / 10, 1);
+
+        if (small_size_ > 0
+            && (small_size_ >= maxSmallSize || main_begin_ == policy_container::end())) {
+          typename parent_trie::iterator victim = &(*policy_container::begin());
+          if (get_hook(victim).frequency > 0) {
+            remove(victim);
+            get_hook(victim).frequency = 0;
+            push_main(victim);
+          }
+          else {
+            ghost_.push(detail::full_key_hash(victim));
+            base_.erase(victim);
+          }
+        }
+        else {
+          typename parent_trie::iterator victim = &(*main_begin_);
+          if (get_hook(victim).frequency > 0) {
+            remove(victim);
+            get_hook(victim).frequency--;
+            push_main(victim);
+          }
+          else {
+            base_.erase(victim);
+          }
+        }
+      }
+
+      void
+      push_main(typename parent_trie::iterator item)
+      {
+        get_hook(item).in_main = true;
+        policy_container::push_back(*item);
+        if (main_begin_ == policy_container::end()) {
+          main_begin_ = policy_container::s_iterator_to(*item);
+        }
+      }
+
+      void
+      remove(typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position == main_begin_) {
+          ++main_begin_;
+        }
+        if (!get_hook(item).in_main) {
+          small_size_--;
+        }
+        policy_container::erase(position);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      static const uint8_t MAX_FREQUENCY = 3;
+
+      Base& base_;
+      size_t max_size_;
+
+      size_t small_size_;
+      typename policy_container::iterator main_begin_;
+      detail::ghost_list ghost_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // S3_FIFO_POLICY_H_
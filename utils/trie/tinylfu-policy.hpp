@@ -0,0 +1,306 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/ghost-list.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+namespace detail {
+
+/**
+ * @brief Approximate frequency histogram: count-min sketch with 4-bit saturating counters,
+ *        doorkeeper Bloom filter and periodic aging
+ *
+ * The first access to a key only sets the doorkeeper bits, so one-hit wonders never reach the
+ * counters.  After the number of recorded accesses reaches the sample size, all counters are
+ * halved and the doorkeeper is reset, so that the sketch tracks recent popularity.
+ */
+class frequency_sketch {
+public:
+  frequency_sketch()
+    : mask_(0)
+    , additions_(0)
+    , sample_size_(0)
+  {
+  }
+
+  /**
+   * @brief Resize the sketch for a cache of the given capacity (resets all statistics)
+   */
+  void
+  resize(size_t capacity)
+  {
+    if (capacity > MAX_CAPACITY) {
+      capacity = MAX_CAPACITY;
+    }
+
+    size_t width = 16;
+    while (width < capacity) {
+      width <<= 1;
+    }
+
+    mask_ = width - 1;
+    counters_.assign(DEPTH * width, 0);
+    additions_ = 0;
+    sample_size_ = SAMPLE_FACTOR * std::max<size_t>(capacity, 1);
+    // doorkeeper needs to remember every key seen within the sample
+    doorkeeper_.assign(sample_size_ * DOORKEEPER_BITS_PER_ENTRY, false);
+  }
+
+  bool
+  empty() const
+  {
+    return counters_.empty();
+  }
+
+  /**
+   * @brief Record access to the key
+   */
+  void
+  increment(size_t hash)
+  {
+    if (!doorkeeper_contains(hash)) {
+      doorkeeper_insert(hash);
+    }
+    else {
+      for (size_t row = 0; row < DEPTH; row++) {
+        uint8_t& counter = counters_[index(hash, row)];
+        if (counter < MAX_COUNT) {
+          counter++;
+        }
+      }
+    }
+
+    if (++additions_ >= sample_size_) {
+      age();
+    }
+  }
+
+  /**
+   * @brief Estimate number of recent accesses to the key
+   */
+  uint32_t
+  estimate(size_t hash) const
+  {
+    uint32_t frequency = MAX_COUNT;
+    for (size_t row = 0; row < DEPTH; row++) {
+      frequency = std::min<uint32_t>(frequency, counters_[index(hash, row)]);
+    }
+
+    return frequency + (doorkeeper_contains(hash) ? 1 : 0);
+  }
+
+private:
+  void
+  age()
+  {
+    for (auto& counter : counters_) {
+      counter >>= 1;
+    }
+    std::fill(doorkeeper_.begin(), doorkeeper_.end(), false);
+    additions_ /= 2;
+  }
+
+  static size_t
+  rehash(size_t hash, size_t seed)
+  {
+    uint64_t h = (static_cast<uint64_t>(hash) + seed) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  size_t
+  index(size_t hash, size_t row) const
+  {
+    return row * (mask_ + 1) + (rehash(hash, row + 1) & mask_);
+  }
+
+  bool
+  doorkeeper_contains(size_t hash) const
+  {
+    for (size_t i = 0; i < DOORKEEPER_HASHES; i++) {
+      if (!doorkeeper_[rehash(hash, DEPTH + 1 + i) % doorkeeper_.size()])
+        return false;
+    }
+    return true;
+  }
+
+  void
+  doorkeeper_insert(size_t hash)
+  {
+    for (size_t i = 0; i < DOORKEEPER_HASHES; i++) {
+      doorkeeper_[rehash(hash, DEPTH + 1 + i) % doorkeeper_.size()] = true;
+    }
+  }
+
+private:
+  static const size_t MAX_CAPACITY = 1 << 24; // avoid huge allocations for "unlimited" caches
+  static const size_t DEPTH = 4;
+  static const uint8_t MAX_COUNT = 15;
+  static const size_t SAMPLE_FACTOR = 10;
+  static const size_t DOORKEEPER_HASHES = 3;
+  static const size_t DOORKEEPER_BITS_PER_ENTRY = 8;
+
+  size_t mask_;
+  std::vector<uint8_t> counters_;
+  std::vector<bool> doorkeeper_;
+  size_t additions_;
+  size_t sample_size_;
+};
+
+} // detail
+
+/**
+ * @brief Traits for TinyLFU admission policy
+ *
+ * This policy does not evict anything by itself and is intended to be combined with a
+ * replacement policy using multi_policy_traits.  The replacement policy must be the first in the
+ * list (it defines the eviction order, size, and iteration), while TinyLFU must be the last one,
+ * so it is consulted before the replacement policy makes room for the new entry:
+ *
+ *     multi_policy_traits<boost::mpl::vector2<lru_policy_traits, tinylfu_policy_traits>>
+ *
+ * When the container is full, a new entry is admitted only if its estimated recent access
+ * frequency is higher than the frequency of the entry that the replacement policy would evict.
+ */
+struct tinylfu_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "TinyLfu";
+  }
+
+  struct policy_hook_type {
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef policy_hook_type type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    // could be just typedef
+    class type {
+    public:
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        // do nothing
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        if (sketch_.empty()) {
+          sketch_.resize(max_size_);
+        }
+
+        size_t candidate = detail::full_key_hash(item);
+        sketch_.increment(candidate);
+
+        if (max_size_ == 0 || base_.getPolicy().size() < max_size_) {
+          return true; // there is still room, nobody needs to be evicted
+        }
+
+        typename parent_trie::iterator victim = &(*base_.getPolicy().begin());
+        return sketch_.estimate(candidate) > sketch_.estimate(detail::full_key_hash(victim));
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        if (!sketch_.empty()) {
+          sketch_.increment(detail::full_key_hash(item));
+        }
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        // do nothing, access history outlives the entries
+      }
+
+      inline void
+      clear()
+      {
+        // do nothing
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        if (max_size != max_size_ || sketch_.empty()) {
+          max_size_ = max_size;
+          sketch_.resize(max_size_);
+        }
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Estimated recent access frequency of the item
+       */
+      inline uint32_t
+      get_frequency(typename parent_trie::iterator item) const
+      {
+        return sketch_.empty() ? 0 : sketch_.estimate(detail::full_key_hash(item));
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+      detail::frequency_sketch sketch_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // TINYLFU_POLICY_H_
@@ -24,6 +24,8 @@
 
 #include "trie.hpp"
 
+#include <functional>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
@@ -86,6 +88,9 @@ public:
     if (node == end())
       return;
 
+    if (erase_callback_)
+      erase_callback_(node);
+
     policy_.erase(s_iterator_to(node));
     node->erase(); // will do cleanup here
   }
@@ -283,6 +288,17 @@ public:
     return policy_;
   }
 
+  /**
+   * @brief Set callback called before an entry is erased, both explicitly and by the policy
+   *
+   * Not called by clear()
+   */
+  void
+  set_erase_callback(const std::function<void(iterator)>& callback)
+  {
+    erase_callback_ = callback;
+  }
+
   static inline iterator
   s_iterator_to(typename parent_trie::iterator item)
   {
@@ -295,6 +311,7 @@ public:
 private:
   parent_trie trie_;
   mutable policy_container policy_;
+  std::function<void(iterator)> erase_callback_;
 };
 
 } // ndnSIM
@@ -453,6 +453,12 @@ public:
     return key_;
   }
 
+  const_iterator
+  parent() const
+  {
+    return parent_;
+  }
+
   inline void
   PrintStat(std::ostream& os) const;
 
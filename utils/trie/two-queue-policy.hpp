@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2020  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TWO_QUEUE_POLICY_H_
+#define TWO_QUEUE_POLICY_H_
+
+/// @cond include_hidden
+
+#include "detail/ghost-list.hpp"
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for 2Q replacement policy (Johnson & Shasha, VLDB'94)
+ *
+ * New entries are placed into the A1in FIFO queue (25% of the cache).  Entries evicted from A1in
+ * are remembered in the A1out history (keys only), and only entries that are requested again while
+ * in A1out are promoted to the main Am LRU queue.  A sequential scan therefore passes through A1in
+ * without disturbing the Am queue.
+ *
+ * All cached entries are kept in a single list: A1in (oldest first) followed by Am (least recently
+ * used first).
+ */
+struct two_queue_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "TwoQ";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    bool in_main;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static bool&
+    in_main(typename Container::iterator item)
+    {
+      return static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item))
+        ->in_main;
+    }
+
+    // could be just typedef
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to in_main methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , in_size_(0)
+        , main_begin_(policy_container::end())
+      {
+        history_.set_capacity(max_size_ / 2);
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        lookup(item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        bool wasSeen = history_.erase(detail::full_key_hash(item));
+
+        if (max_size_ != 0) {
+          while (policy_container::size() >= max_size_) {
+            reclaim();
+          }
+        }
+
+        if (wasSeen) {
+          push_main(item);
+        }
+        else {
+          in_main(item) = false;
+          policy_container::insert(main_begin_, *item);
+          in_size_++;
+        }
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        if (in_main(item)) {
+          // do relocation within Am
+          remove(item);
+          push_main(item);
+        }
+        // hits in A1in do not change the order
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        remove(item);
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        in_size_ = 0;
+        main_begin_ = policy_container::end();
+        history_.clear();
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+        history_.set_capacity(max_size_ / 2);
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+    private:
+      void
+      reclaim()
+      {
+        size_t maxInSize = std::max<size_t>(max_size_ / 4, 1);
+        if (in_size_ > 0 && (in_size_ >= maxInSize || main_begin_ == policy_container::end())) {
+          typename parent_trie::iterator victim = &(*policy_container::begin());
+          history_.push(detail::full_key_hash(victim));
+          base_.erase(victim);
+        }
+        else {
+          base_.erase(&(*main_begin_));
+        }
+      }
+
+      void
+      push_main(typename parent_trie::iterator item)
+      {
+        in_main(item) = true;
+        policy_container::push_back(*item);
+        if (main_begin_ == policy_container::end()) {
+          main_begin_ = policy_container::s_iterator_to(*item);
+        }
+      }
+
+      void
+      remove(typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator position = policy_container::s_iterator_to(*item);
+        if (position == main_begin_) {
+          ++main_begin_;
+        }
+        if (!in_main(item)) {
+          in_size_--;
+        }
+        policy_container::erase(position);
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      size_t max_size_;
+
+      size_t in_size_;
+      typename policy_container::iterator main_begin_;
+      detail::ghost_list history_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // TWO_QUEUE_POLICY_H_